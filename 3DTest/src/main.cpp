@@ -7,19 +7,11 @@
 #include "Engine.h"
 #include "maths/Maths.h"
 #include "maths/vector/float3.h"
+#include "geom/Camera3D.h"
 using namespace displib;
 
 static std::string FILENAME;
 
-//i really havent a clue where i got this
-//i believe it is x and z matrix rotations, without z
-float2 projfloat3(float3 v, float yaw, float pitch, float zoom) {
-	return float2(
-		sinf(yaw)*v.x-cosf(yaw)*v.z,
-		(cosf(yaw)*v.x+sinf(yaw)*v.z)*cosf(pitch)+sinf(pitch)*v.y
-	)*zoom;
-}
-
 //i didnt want to use a vector of arrays so, this is the "bodge"
 struct triIndex { int a, b, c; };
 struct tri {
@@ -35,6 +27,8 @@ struct tri {
 };
 
 struct mesh {
+	std::vector<float3> vtxs;
+	std::vector<triIndex> tIxs;
 	std::vector<tri> tris;
 
 	//load obj file
@@ -43,9 +37,6 @@ struct mesh {
 		std::regex indexRegex("([0-9]+)[/0-9]*");
 		if (!file.is_open()) return false;
 
-		std::vector<float3> vtxs;
-		std::vector<triIndex> tIxs;
-
 		//get extreme points
 		float nx=INFINITY, ny=INFINITY, nz=INFINITY;
 		float mx=-INFINITY, my=-INFINITY, mz=-INFINITY;
@@ -109,12 +100,17 @@ class Demo : public Engine {
 	float camYaw=-0.983478f, camPitch=-1.922638f;
 	float camZoom;
 
+	Camera3D cam;
+	std::vector<float2> projected;
+	std::vector<float> depths;
+
 	const char* asciiArr=" .,~=#&@";
 
 	void setup() override {
 		mainMesh.loadFromFile(FILENAME);
 
 		ctr=float2(width/2, height/2);
+		cam.pool=&tasks;
 
 		lightPos=float3(60, 40, 90);
 
@@ -173,22 +169,34 @@ class Demo : public Engine {
 		rst.setChar(' ');
 		rst.fillRect(0, 0, width, height);
 
+		//project every vertex once
+		cam.setOrbit(camYaw, camPitch, 120, camZoom, ctr);
+		int vtxNum=mainMesh.vtxs.size();
+		projected.resize(vtxNum);
+		depths.resize(vtxNum);
+		cam.projectBatch(mainMesh.vtxs.data(), projected.data(), depths.data(), vtxNum);
+
 		//"optimization" show only front facing tris
-		std::vector<tri> trisToDraw;
-		for (auto& t:mainMesh.tris) {
-			//culling
-			if (dot(t.getNorm(), t.a-camPos)<0) {
-				trisToDraw.push_back(t);
+		std::vector<int> trisToDraw;
+		for (int i=0; i<mainMesh.tIxs.size(); i++) {
+			triIndex& tIx=mainMesh.tIxs[i];
+			//culling by screen winding
+			if (Camera3D::isFrontFacing(projected[tIx.a], projected[tIx.b], projected[tIx.c])) {
+				trisToDraw.push_back(i);
 			}
 		}
 
 		//"painters"-ish algo to sort by what is closer to the "camera"
-		sort(trisToDraw.begin(), trisToDraw.end(), [&](tri& a, tri& b) {
-			return length(a.getAvgPos()-camPos)>length(b.getAvgPos()-camPos);
+		sort(trisToDraw.begin(), trisToDraw.end(), [&](int a, int b) {
+			triIndex& ta=mainMesh.tIxs[a];
+			triIndex& tb=mainMesh.tIxs[b];
+			return depths[ta.a]+depths[ta.b]+depths[ta.c]>depths[tb.a]+depths[tb.b]+depths[tb.c];
 		});
 
 		//"project" tris
-		for (auto& t:trisToDraw) {
+		for (int i:trisToDraw) {
+			tri& t=mainMesh.tris[i];
+			triIndex& tIx=mainMesh.tIxs[i];
 			float3 tPos=t.getAvgPos();
 			float3 tNorm=t.getNorm();
 			//diffuse is norm vs lightdir, "direct lighting"
@@ -200,9 +208,9 @@ class Demo : public Engine {
 			rst.setChar(asciiArr[asi]);
 
 			//get projected coords
-			float2 a=projfloat3(t.a, camYaw, camPitch, camZoom)+ctr;
-			float2 b=projfloat3(t.b, camYaw, camPitch, camZoom)+ctr;
-			float2 c=projfloat3(t.c, camYaw, camPitch, camZoom)+ctr;
+			float2 a=projected[tIx.a];
+			float2 b=projected[tIx.b];
+			float2 c=projected[tIx.c];
 			rst.fillTriangle(a, b, c);
 
 			//show wireframe
@@ -213,8 +221,8 @@ class Demo : public Engine {
 
 			//show tri normals
 			if (showNorm) {
-				float2 mid=projfloat3(tPos, camYaw, camPitch, camZoom)+ctr;
-				float2 midEx=projfloat3(tPos+tNorm/25, camYaw, camPitch, camZoom)+ctr;
+				float2 mid=cam.project(tPos);
+				float2 midEx=cam.project(tPos+tNorm/25);
 				rst.drawLine(mid, midEx);
 			}
 		}
@@ -40,6 +40,10 @@ class Demo : public Engine {
 
 	float timer=0;
 
+	Metrics::Id openId=Metrics::gauge("open set", "nodes left to look at");
+	Metrics::Id closedId=Metrics::gauge("closed set", "nodes already looked at");
+	Metrics::Id stepsId=Metrics::counter("steps", "nodes expanded");
+
 	bool inRange(int i, int j) {
 		return i>=0&&j>=0&&i<width&& j<height;
 	}
@@ -161,6 +165,7 @@ class Demo : public Engine {
 
 				//add curr to CLOSED
 				closedSet.push_back(currNode);
+				Metrics::add(stepsId);
 
 				if (currNode==endNode) {
 					running=false;
@@ -211,6 +216,9 @@ class Demo : public Engine {
 		}
 		timer+=dt;
 
+		Metrics::set(openId, openSet.size());
+		Metrics::set(closedId, closedSet.size());
+
 		//update title
 		std::string fpsStr=std::to_string((int)framesPerSecond)+"fps";
 		std::string runStr=running?"running":"not running";
@@ -2,6 +2,7 @@
 #include <algorithm>
 
 #include "Engine.h"
+#include "maths/Random.h"
 using namespace displib;
 
 #define NODE_SIZE 2.49f
@@ -313,7 +314,7 @@ class Demo : public Engine {
 };
 
 int main() {
-	srand(time(NULL));
+	Random::seed(time(NULL));
 
 	//init custom graphics engine
 	Demo d;
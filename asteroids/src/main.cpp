@@ -4,6 +4,7 @@
 #include "Engine.h"
 #include "geom/AABB2D.h"
 #include "maths/Maths.h"
+#include "maths/Random.h"
 using namespace displib;
 
 float2 float2FromAngle(float angle) {
@@ -56,9 +57,12 @@ struct Asteroid {
 	float2* model=nullptr, * points=nullptr;
 	int numPts=0;
 
+	//hull bounds, found once per update
+	AABB2D bounds;
+
 	Asteroid() {}
 
-	Asteroid(float2 pos_, float2 vel_, float rad_, int numPts_) {
+	Asteroid(float2 pos_, float2 vel_, float rad_, int numPts_, Random& rng) {
 		pos=pos_;
 		vel=vel_;
 		rad=rad_;
@@ -67,15 +71,23 @@ struct Asteroid {
 		points=new float2[numPts];
 		for (int i=0; i<numPts; i++) {
 			float angle=((float)i/(float)numPts)*Maths::PI*2;
-			model[i]=float2FromAngle(angle)*Maths::random(rad*2/3, rad);
+			model[i]=float2FromAngle(angle)*rng.nextFloat(rad*2/3, rad);
 		}
 	}
 
 	void update(float dt) {
 		pos+=vel*dt;
+		//sort to find extreme points while placing them
+		float nx=INFINITY, ny=INFINITY, mx=-INFINITY, my=-INFINITY;
 		for (int i=0; i<numPts; i++) {
-			points[i]=model[i]+pos;
+			float2 p=model[i]+pos;
+			points[i]=p;
+			nx=min(nx, p.x);
+			ny=min(ny, p.y);
+			mx=max(mx, p.x);
+			my=max(my, p.y);
 		}
+		bounds=AABB2D(nx, ny, mx, my);
 	}
 
 	//toroidal space
@@ -87,27 +99,18 @@ struct Asteroid {
 	}
 
 	//can or should this be split more?
-	bool split(Asteroid& a, Asteroid& b) {
+	bool split(Asteroid& a, Asteroid& b, Random& rng) {
 		//if asteroid is too small or not enough pts, dont bother splitting it
 		if (rad<10||numPts<7) return false;
-		float spdA=Maths::random(0.75f, 1), spdB=Maths::random(0.75f, 1);
-		float radA=Maths::random(0.5f, 0.8f), radB=Maths::random(0.5f, 0.8f);
-		a=Asteroid(pos, float2(-vel.y, vel.x)*spdA, rad*radA, numPts-4);
-		b=Asteroid(pos, float2(vel.y, -vel.x)*spdB, rad*radB, numPts-4);
+		float spdA=rng.nextFloat(0.75f, 1), spdB=rng.nextFloat(0.75f, 1);
+		float radA=rng.nextFloat(0.5f, 0.8f), radB=rng.nextFloat(0.5f, 0.8f);
+		a=Asteroid(pos, float2(-vel.y, vel.x)*spdA, rad*radA, numPts-4, rng);
+		b=Asteroid(pos, float2(vel.y, -vel.x)*spdB, rad*radB, numPts-4, rng);
 		return true;
 	}
 
 	AABB2D getAABB() {
-		//sort to find extreme points
-		float nx=INFINITY, ny=INFINITY, mx=-INFINITY, my=-INFINITY;
-		for (int i=0; i<numPts; i++) {
-			float2 p=points[i];
-			nx=min(nx, p.x);
-			ny=min(ny, p.y);
-			mx=max(mx, p.x);
-			my=max(my, p.y);
-		}
-		return AABB2D(nx, ny, mx, my);
+		return bounds;
 	}
 
 	//is pt inside asteroid?
@@ -182,10 +185,10 @@ struct Ship {
 	}
 
 	//random particle at end of ship
-	Particle emitParticle() {
-		float randAngle=Maths::random(-Maths::PI/3, Maths::PI/3);
-		float speed=Maths::random(3, 6);
-		float lifespan=Maths::random(1.6f, 3.8f);
+	Particle emitParticle(Random& rng) {
+		float randAngle=rng.nextFloat(-Maths::PI/3, Maths::PI/3);
+		float speed=rng.nextFloat(3, 6);
+		float lifespan=rng.nextFloat(1.6f, 3.8f);
 		float2 vel=float2FromAngle(rot+Maths::PI+randAngle)*speed;
 		return {pos-float2FromAngle(rot+randAngle/2)*rad, vel, lifespan};
 	}
@@ -231,35 +234,46 @@ class Demo : public Engine {
 	bool won=false, lost=false;
 	int warningStage=0, endStage=0;
 	bool keyDown=false, debugMode=false;
+	bool boostKey=false;
+
+	//tasks run on any worker, so they draw from here, not the thread's stream
+	Random rng;
 
 	float2 randomPtOnEdge(AABB2D a) {
-		float pct=Maths::random();
-		if (pct<0.25f) return float2(Maths::random(a.min.x, a.max.x), a.min.y);//top
-		else if (pct<0.5f) return float2(Maths::random(a.min.x, a.max.x), a.max.y);//bottom
-		else if (pct<0.75f) return float2(a.min.x, Maths::random(a.min.y, a.max.y));//left
-		else return float2(a.max.x, Maths::random(a.min.y, a.max.y));//right
+		float pct=rng.nextFloat();
+		if (pct<0.25f) return float2(rng.nextFloat(a.min.x, a.max.x), a.min.y);//top
+		else if (pct<0.5f) return float2(rng.nextFloat(a.min.x, a.max.x), a.max.y);//bottom
+		else if (pct<0.75f) return float2(a.min.x, rng.nextFloat(a.min.y, a.max.y));//left
+		else return float2(a.max.x, rng.nextFloat(a.min.y, a.max.y));//right
 	}
 
 	Asteroid randomAsteroid() {
-		float angle=Maths::random(-Maths::PI, Maths::PI);
-		float speed=Maths::random(15, 27);
-		float rad=Maths::random(width/16, width/10);
-		int numPts=Maths::random(20, 28);
-		return Asteroid(randomPtOnEdge(bounds), float2FromAngle(angle)*speed, rad, numPts);
+		float angle=rng.nextFloat(-Maths::PI, Maths::PI);
+		float speed=rng.nextFloat(15, 27);
+		float rad=rng.nextFloat(width/16, width/10);
+		int numPts=rng.nextFloat(20, 28);
+		return Asteroid(randomPtOnEdge(bounds), float2FromAngle(angle)*speed, rad, numPts, rng);
 	}
 
 	void randomParticle(float2 pos, Particle& p) {
-		float randAngle=Maths::random(-Maths::PI, Maths::PI);
-		float speed=Maths::random(1, 6);
-		float lifespan=Maths::random(1.6f, 3.8f);
+		float randAngle=rng.nextFloat(-Maths::PI, Maths::PI);
+		float speed=rng.nextFloat(1, 6);
+		float lifespan=rng.nextFloat(1.6f, 3.8f);
 		float2 vel=float2FromAngle(randAngle)*speed;
 		p={pos, vel, lifespan};
 	}
 
 	void setup() override {
+		rng.setSeed(Random::local().next());
 		bounds=AABB2D(0, 0, width, height);
 
 		ship=Ship(float2(width/2, height/2), 4);
+
+		//particles and bullets dont touch each other, asteroids hit both
+		addTask("particles", [this](float dt) { updateParticles(dt); });
+		addTask("bullets", [this](float dt) { updateBullets(dt); });
+		addTask("asteroids", [this](float dt) { updateAsteroids(dt); }, {"particles", "bullets"});
+		addTask("game", [this](float dt) { updateGame(dt); }, {"asteroids"});
 	}
 
 	void update(float dt) override {
@@ -271,6 +285,22 @@ class Demo : public Engine {
 		}
 		if (!switchKey&&keyDown) keyDown=false;
 
+		//if "alive"
+		boostKey=getKey(VK_UP);
+		if (!lost) {
+			//ship movement
+			if (boostKey) ship.boost(87.43f);
+			float turnSpeed=2.78f;
+			if (getKey(VK_RIGHT)) ship.turn(turnSpeed*dt);
+			if (getKey(VK_LEFT))  ship.turn(-turnSpeed*dt);
+
+			//ship update
+			ship.update(dt);
+			ship.checkAABB(bounds);
+		}
+	}
+
+	void updateParticles(float dt) {
 		//update particles
 		for (int i=particles.size()-1; i>=0; i--) {
 			Particle& p=particles.at(i);
@@ -281,7 +311,9 @@ class Demo : public Engine {
 				particles.erase(particles.begin()+i);
 			}
 		}
+	}
 
+	void updateBullets(float dt) {
 		//update bullets
 		for (int i=bullets.size()-1; i>=0; i--) {
 			Bullet& b=bullets.at(i);
@@ -292,21 +324,9 @@ class Demo : public Engine {
 				bullets.erase(bullets.begin()+i);
 			}
 		}
+	}
 
-		//if "alive"
-		bool boostKey=getKey(VK_UP);
-		if (!lost) {
-			//ship movement
-			if (boostKey) ship.boost(87.43f);
-			float turnSpeed=2.78f;
-			if (getKey(VK_RIGHT)) ship.turn(turnSpeed*dt);
-			if (getKey(VK_LEFT))  ship.turn(-turnSpeed*dt);
-
-			//ship update
-			ship.update(dt);
-			ship.checkAABB(bounds);
-		}
-
+	void updateAsteroids(float dt) {
 		//update asteroids
 		float2* shipOutline=ship.outline();
 		for (int i=asteroids.size()-1; i>=0; i--) {
@@ -334,7 +354,7 @@ class Demo : public Engine {
 				}
 				if (shipHit) {//end game
 					lost=true;
-					int numRand=Maths::random(56, 84);
+					int numRand=rng.nextFloat(56, 84);
 					for (int i=0; i<numRand; i++) {
 						Particle p;
 						randomParticle(ship.pos, p);
@@ -355,11 +375,11 @@ class Demo : public Engine {
 					int numRand;
 					float2 pos;
 					Asteroid newA, newB;
-					if (a.split(newA, newB)) {
+					if (a.split(newA, newB, rng)) {
 						asteroids.push_back(newA);
 						asteroids.push_back(newB);
 						//emit some particles for fx
-						numRand=a.rad*Maths::random(2, 4);
+						numRand=a.rad*rng.nextFloat(2, 4);
 						pos=newA.pos;
 
 						//increment score
@@ -367,7 +387,7 @@ class Demo : public Engine {
 					}
 					else {//when we "fully" break an asteroid
 						//emit more particles
-						numRand=a.rad*Maths::random(5, 7);
+						numRand=a.rad*rng.nextFloat(5, 7);
 						pos=a.pos;
 
 						//increment score more
@@ -384,12 +404,14 @@ class Demo : public Engine {
 			}
 		}
 		delete[] shipOutline;
+	}
 
+	void updateGame(float dt) {
 		if (!lost) {
 			//limit number of particles spawned
 			if (particleTimer>0.003f) {
 				particleTimer=0;
-				if (boostKey) particles.push_back(ship.emitParticle());
+				if (boostKey) particles.push_back(ship.emitParticle(rng));
 			}
 			particleTimer+=dt;
 
@@ -553,7 +575,7 @@ class Demo : public Engine {
 };
 
 int main() {
-	srand(time(NULL));
+	Random::seed(time(NULL));
 
 	//init custom graphics engine
 	Demo d=Demo();
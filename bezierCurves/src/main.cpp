@@ -3,14 +3,21 @@
 
 #include "Engine.h"
 #include "maths/Maths.h"
+#include "maths/Random.h"
+#include "geom/Curve.h"
+#include "geom/Polyline.h"
 using namespace displib;
 
 class Demo : public Engine {
 	public:
 	float2 p0, p1, p2, p3;
-	std::vector<float2> trail;
 	float timer=0;
 
+	//sampled at a fixed rate so the trail is two seconds long whatever the fps
+	Polyline trail=Polyline(240);
+	float trailTimer=0;
+	std::vector<float2> curvePts;
+
 	float2 randomPt() {
 		//random in screen
 		return float2(
@@ -42,9 +49,20 @@ class Demo : public Engine {
 
 		timer+=dt;
 
+		//add to trail, each point at its own sub step's time, totalDeltaTime is still the frame start here
+		trailTimer+=dt;
+		while (trailTimer>1/120.f) {
+			trailTimer-=1/120.f;
+			trail.push(Curve::cubic(p0, p1, p2, p3, curveT(totalDeltaTime+dt-trailTimer)));
+		}
+
 		setTitle("Bezier Curves @ "+std::to_string((int)framesPerSecond)+"fps");
 	}
 
+	float curveT(float time) {
+		return Maths::map(cosf(time*0.67f), -1, 1, 0, 1);
+	}
+
 	void draw(Raster& rst) override {
 		//background
 		rst.setChar(' ');
@@ -57,8 +75,14 @@ class Demo : public Engine {
 		rst.drawLine(p1, p2);
 		rst.drawLine(p2, p3);
 
+		//whole curve, faintly
+		curvePts.clear();
+		Curve::flattenCubic(p0, p1, p2, p3, 0.25f, curvePts);
+		rst.setColor(Raster::DARK_GREY);
+		rst.drawPolyline(curvePts);
+
 		//draw first lerps
-		float t=Maths::map(cosf(totalDeltaTime*0.67f), -1, 1, 0, 1);
+		float t=curveT(totalDeltaTime);
 		float2 lp0=lerp(p0, p1, t);
 		float2 lp1=lerp(p1, p2, t);
 		float2 lp2=lerp(p2, p3, t);
@@ -75,20 +99,7 @@ class Demo : public Engine {
 		//draw trail
 		rst.setChar('#');
 		rst.setColor(Raster::CYAN);
-		float2 finalPt=lerp(llp0, llp1, t);
-		int num=trail.size();
-		if (num>1) {
-			for (int i=1; i<num; i++) {
-				float2 a=trail.at(i);
-				float2 b=trail.at(i-1);
-				rst.drawLine(a, b);
-			}
-		}
-		//update trail, make sure it is not too long
-		trail.push_back(finalPt);
-		if (num>framesPerSecond*2) {
-			trail.erase(trail.begin());
-		}
+		rst.drawPolyline(trail);
 
 		//draw pts
 		rst.setChar('@');
@@ -101,7 +112,7 @@ class Demo : public Engine {
 };
 
 int main() {
-	srand(time(NULL));
+	Random::seed(time(NULL));
 
 	//init custom graphics engine
 	Demo d=Demo();
@@ -6,18 +6,12 @@
 
 #include "Engine.h"
 #include "maths/Maths.h"
+#include "maths/Random.h"
 #include "maths/vector/float3.h"
+#include "geom/Camera3D.h"
+#include "io/Snapshot.h"
 using namespace displib;
 
-//i really havent a clue where i got this
-//i believe it is x and z matrix rotations, without z
-float2 projfloat3(float3 v, float yaw, float pitch, float zoom) {
-	return float2(
-		sinf(yaw)*v.x-cosf(yaw)*v.z,
-		(cosf(yaw)*v.x+sinf(yaw)*v.z)*cosf(pitch)+sinf(pitch)*v.y
-	)*zoom;
-}
-
 int modulo(int x, int n) {
 	return (x%n+n)%n;
 }
@@ -75,6 +69,10 @@ class Demo : public Engine {
 
 	float camYaw=-0.983478f, camPitch=-1.922638f;
 	float camZoom;
+	Camera3D cam;
+
+	bool save=false, wasSave=false;
+	bool load=false, wasLoad=false;
 
 	int ix(int i, int j) {
 		return i+j*wid;
@@ -136,7 +134,41 @@ class Demo : public Engine {
 		}
 	}
 
+	void saveSnapshot() {
+		//the torus is rebuilt by setup, only which cells are lit is state
+		std::vector<uint8_t> lit(cellNum);
+		for (int i=0; i<cellNum; i++) lit[i]=cells[i].lit;
+		float view[3]{camYaw, camPitch, camZoom};
+
+		SnapshotWriter out("cellularAutomata3d.snap");
+		out.put("lit", lit);
+		out.put("view", view, 3);
+		out.putValue("timr", timer);
+		out.close();
+	}
+
+	void loadSnapshot() {
+		SnapshotReader in("cellularAutomata3d.snap");
+		const uint8_t* lit=in.view<uint8_t>("lit", cellNum);
+		const float* view=in.view<float>("view", 3);
+		if (!lit||!view) return;
+
+		for (int i=0; i<cellNum; i++) cells[i].updateLit(lit[i]);
+		camYaw=view[0];
+		camPitch=view[1];
+		camZoom=view[2];
+		in.getValue("timr", timer);
+	}
+
 	void update(float dt) override {
+		//snapshot to file and back
+		save=getKey(VK_F5);
+		if (save&&!wasSave) saveSnapshot();
+		wasSave=save;
+		load=getKey(VK_F9);
+		if (load&&!wasLoad) loadSnapshot();
+		wasLoad=load;
+
 		//update "campos"
 		camPos=float3(
 			cosf(camYaw)*sinf(camPitch),
@@ -238,13 +270,14 @@ class Demo : public Engine {
 		});
 
 		//"project" tris
+		cam.setOrbit(camYaw, camPitch, 120, camZoom, ctr);
 		bool drawOutline=!getKey('O');
 		rst.setColor(Raster::CYAN);
 		for (tri& t:trisToDraw) {
 			//get projected coords
-			float2 a=projfloat3(t.a, camYaw, camPitch, camZoom)+ctr;
-			float2 b=projfloat3(t.b, camYaw, camPitch, camZoom)+ctr;
-			float2 c=projfloat3(t.c, camYaw, camPitch, camZoom)+ctr;
+			float2 a=cam.project(t.a);
+			float2 b=cam.project(t.b);
+			float2 c=cam.project(t.c);
 
 			//show based on "lit"
 			rst.setChar(t.lit?0x2588:' ');
@@ -260,7 +293,7 @@ class Demo : public Engine {
 };
 
 int main() {
-	srand(time(NULL));
+	Random::seed(time(NULL));
 
 	Demo d;
 	d.startWindowed(4, 240, 200);
@@ -4,6 +4,7 @@
 
 #include "geom/AABB2D.h"
 #include "maths/Maths.h"
+#include "maths/Random.h"
 using namespace displib;
 
 struct ptc {
@@ -215,7 +216,7 @@ class Demo : public Engine {
 };
 
 int main() {
-	srand(time(NULL));
+	Random::seed(time(NULL));
 
 	//init custom graphics engine
 	Demo d=Demo();
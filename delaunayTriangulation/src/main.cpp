@@ -3,6 +3,7 @@
 #include "Engine.h"
 #include "geom/AABB2D.h"
 #include "maths/Maths.h"
+#include "maths/Random.h"
 using namespace displib;
 
 float2 rayRayIntersect(float2 a, float2 b, float2 c, float2 d) {
@@ -288,7 +289,7 @@ class Demo : public Engine {
 };
 
 int main() {
-	srand(time(NULL));
+	Random::seed(time(NULL));
 
 	//init custom graphics engine
 	Demo d;
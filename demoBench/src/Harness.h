@@ -0,0 +1,64 @@
+//every header the demos include, pulled in here first so their includes inside a namespace are skipped.
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <list>
+#include <regex>
+#include <string>
+#include <strstream>
+#include <thread>
+#include <time.h>
+#include <unordered_map>
+#include <vector>
+
+#include "Engine.h"
+#include "geom/AABB2D.h"
+#include "geom/AABB3D.h"
+#include "geom/AABBArray.h"
+#include "geom/BVH.h"
+#include "geom/Camera3D.h"
+#include "geom/Curve.h"
+#include "geom/Polyline.h"
+#include "geom/QuadTree.h"
+#include "geom/SpatialHash2D.h"
+#include "io/Snapshot.h"
+#include "io/Sprite.h"
+#include "maths/Fast.h"
+#include "maths/Maths.h"
+#include "maths/Random.h"
+#include "maths/vector/float2.h"
+#include "maths/vector/float2x8.h"
+#include "maths/vector/float3.h"
+#include "maths/vector/SoA.h"
+
+#pragma once
+//each file in demos/ wraps one demo's main.cpp in a namespace and registers its Demo here.
+struct DemoEntry {
+	std::string name;
+
+	//raster size, fullscreen demos get what a 1920x1080 screen would give them.
+	int w, h;
+	bool halfBlocks;
+
+	std::function<displib::Engine*()> make;
+};
+
+//fullscreen demos are sized for this screen.
+static const int SCREEN_W=1920, SCREEN_H=1080;
+
+inline std::vector<DemoEntry>& demoList() {
+	static std::vector<DemoEntry> list;
+	return list;
+}
+
+struct RegisterDemo {
+	RegisterDemo(const char* name, int w, int h, bool halfBlocks, std::function<displib::Engine*()> make) {
+		demoList().push_back({name, w, h, halfBlocks, make});
+	}
+};
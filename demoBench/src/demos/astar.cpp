@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace astarBench {
+#include "../../../astar/src/main.cpp"
+}
+
+static RegisterDemo reg("astar", 60, 60, false, []() -> displib::Engine* { return new astarBench::Demo(); });
\ No newline at end of file
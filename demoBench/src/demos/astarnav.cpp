@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace astarnavBench {
+#include "../../../astarnav/src/main.cpp"
+}
+
+static RegisterDemo reg("astarnav", 240, 135, false, []() -> displib::Engine* { return new astarnavBench::Demo(); });
\ No newline at end of file
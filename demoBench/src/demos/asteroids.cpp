@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace asteroidsBench {
+#include "../../../asteroids/src/main.cpp"
+}
+
+static RegisterDemo reg("asteroids", SCREEN_W/8, SCREEN_H/8, false, []() -> displib::Engine* { return new asteroidsBench::Demo(); });
\ No newline at end of file
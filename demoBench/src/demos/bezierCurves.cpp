@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace bezierCurvesBench {
+#include "../../../bezierCurves/src/main.cpp"
+}
+
+static RegisterDemo reg("bezierCurves", 200, 200, false, []() -> displib::Engine* { return new bezierCurvesBench::Demo(); });
\ No newline at end of file
@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace cellularAutomata3dBench {
+#include "../../../cellularAutomata3d/src/main.cpp"
+}
+
+static RegisterDemo reg("cellularAutomata3d", 240, 200, false, []() -> displib::Engine* { return new cellularAutomata3dBench::Demo(); });
\ No newline at end of file
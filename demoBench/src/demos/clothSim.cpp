@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace clothSimBench {
+#include "../../../clothSim/src/main.cpp"
+}
+
+static RegisterDemo reg("clothSim", 80, 100, false, []() -> displib::Engine* { return new clothSimBench::Demo(); });
\ No newline at end of file
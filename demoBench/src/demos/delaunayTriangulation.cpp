@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace delaunayTriangulationBench {
+#include "../../../delaunayTriangulation/src/main.cpp"
+}
+
+static RegisterDemo reg("delaunayTriangulation", 320, 200, false, []() -> displib::Engine* { return new delaunayTriangulationBench::Demo(); });
\ No newline at end of file
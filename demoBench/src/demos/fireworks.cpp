@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace fireworksBench {
+#include "../../../fireworks/src/main.cpp"
+}
+
+static RegisterDemo reg("fireworks", SCREEN_W/8, SCREEN_H/8, false, []() -> displib::Engine* { return new fireworksBench::Demo(); });
\ No newline at end of file
@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace fluidSimBench {
+#include "../../../fluidSim/src/main.cpp"
+}
+
+static RegisterDemo reg("fluidSim", 108, 60, false, []() -> displib::Engine* { return new fluidSimBench::Demo(); });
\ No newline at end of file
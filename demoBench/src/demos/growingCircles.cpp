@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace growingCirclesBench {
+#include "../../../growingCircles/src/main.cpp"
+}
+
+static RegisterDemo reg("growingCircles", SCREEN_W/8, SCREEN_H/8, false, []() -> displib::Engine* { return new growingCirclesBench::Demo(); });
\ No newline at end of file
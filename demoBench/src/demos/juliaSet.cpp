@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace juliaSetBench {
+#include "../../../juliaSet/src/main.cpp"
+}
+
+static RegisterDemo reg("juliaSet", 240, 190*2, true, []() -> displib::Engine* { return new juliaSetBench::Demo(); });
\ No newline at end of file
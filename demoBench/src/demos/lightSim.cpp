@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace lightSimBench {
+#include "../../../lightSim/src/main.cpp"
+}
+
+static RegisterDemo reg("lightSim", 160, 90, false, []() -> displib::Engine* { return new lightSimBench::Demo(); });
\ No newline at end of file
@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace lissajousCurveTableBench {
+#include "../../../lissajousCurveTable/src/main.cpp"
+}
+
+static RegisterDemo reg("lissajousCurveTable", 720, 405, false, []() -> displib::Engine* { return new lissajousCurveTableBench::Demo(); });
\ No newline at end of file
@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace mandelbrotSetBench {
+#include "../../../mandelbrotSet/src/main.cpp"
+}
+
+static RegisterDemo reg("mandelbrotSet", 190, 190*2, true, []() -> displib::Engine* { return new mandelbrotSetBench::Demo(); });
\ No newline at end of file
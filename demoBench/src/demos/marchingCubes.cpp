@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace marchingCubesBench {
+#include "../../../marchingCubes/src/main.cpp"
+}
+
+static RegisterDemo reg("marchingCubes", 140, 140, false, []() -> displib::Engine* { return new marchingCubesBench::Demo(); });
\ No newline at end of file
@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace metaballsBench {
+#include "../../../metaballs/src/main.cpp"
+}
+
+static RegisterDemo reg("metaballs", SCREEN_W/10, SCREEN_H/10, false, []() -> displib::Engine* { return new metaballsBench::Demo(); });
\ No newline at end of file
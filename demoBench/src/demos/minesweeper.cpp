@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace minesweeperBench {
+#include "../../../minesweeper/src/main.cpp"
+}
+
+static RegisterDemo reg("minesweeper", SCREEN_W/12, SCREEN_H/12, false, []() -> displib::Engine* { return new minesweeperBench::Demo(); });
\ No newline at end of file
@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace particleCollisionsBench {
+#include "../../../particleCollisions/src/main.cpp"
+}
+
+static RegisterDemo reg("particleCollisions", 220, 130, false, []() -> displib::Engine* { return new particleCollisionsBench::Demo(); });
\ No newline at end of file
@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace particleSystemBench {
+#include "../../../particleSystem/src/main.cpp"
+}
+
+static RegisterDemo reg("particleSystem", 320, 180, false, []() -> displib::Engine* { return new particleSystemBench::Demo(); });
\ No newline at end of file
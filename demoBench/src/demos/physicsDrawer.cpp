@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace physicsDrawerBench {
+#include "../../../physicsDrawer/src/main.cpp"
+}
+
+static RegisterDemo reg("physicsDrawer", 240, 135, false, []() -> displib::Engine* { return new physicsDrawerBench::Demo(); });
\ No newline at end of file
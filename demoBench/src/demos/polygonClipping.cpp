@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace polygonClippingBench {
+#include "../../../polygonClipping/src/main.cpp"
+}
+
+static RegisterDemo reg("polygonClipping", 200, 200, false, []() -> displib::Engine* { return new polygonClippingBench::Demo(); });
\ No newline at end of file
@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace quadtreeBench {
+#include "../../../quadtree/src/main.cpp"
+}
+
+static RegisterDemo reg("quadtree", 200, 150, false, []() -> displib::Engine* { return new quadtreeBench::Demo(); });
\ No newline at end of file
@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace raycasterBench {
+#include "../../../raycaster/src/main.cpp"
+}
+
+static RegisterDemo reg("raycaster", SCREEN_W/8, SCREEN_H/8, false, []() -> displib::Engine* { return new raycasterBench::Demo(); });
\ No newline at end of file
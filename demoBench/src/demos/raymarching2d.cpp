@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace raymarching2dBench {
+#include "../../../raymarching2d/src/main.cpp"
+}
+
+static RegisterDemo reg("raymarching2d", SCREEN_W/6, SCREEN_H/6, false, []() -> displib::Engine* { return new raymarching2dBench::Demo(); });
\ No newline at end of file
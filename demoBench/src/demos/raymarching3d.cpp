@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace raymarching3dBench {
+#include "../../../raymarching3d/src/main.cpp"
+}
+
+static RegisterDemo reg("raymarching3d", SCREEN_W/8, SCREEN_H/8, false, []() -> displib::Engine* { return new raymarching3dBench::Demo(); });
\ No newline at end of file
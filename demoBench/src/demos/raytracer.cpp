@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace raytracerBench {
+#include "../../../raytracer/src/main.cpp"
+}
+
+static RegisterDemo reg("raytracer", SCREEN_W/8, SCREEN_H/8, false, []() -> displib::Engine* { return new raytracerBench::Demo(); });
\ No newline at end of file
@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace sandSimBench {
+#include "../../../sandSim/src/main.cpp"
+}
+
+static RegisterDemo reg("sandSim", 160, 90, false, []() -> displib::Engine* { return new sandSimBench::Demo(); });
\ No newline at end of file
@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace softbody2dBench {
+#include "../../../softbody2d/src/main.cpp"
+}
+
+static RegisterDemo reg("softbody2d", 360, 240, false, []() -> displib::Engine* { return new softbody2dBench::Demo(); });
\ No newline at end of file
@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace softbody3dBench {
+#include "../../../softbody3d/src/main.cpp"
+}
+
+static RegisterDemo reg("softbody3d", 90, 110, false, []() -> displib::Engine* { return new softbody3dBench::Demo(); });
\ No newline at end of file
@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace tetrisBench {
+#include "../../../tetris/src/main.cpp"
+}
+
+static RegisterDemo reg("tetris", 88, 96, false, []() -> displib::Engine* { return new tetrisBench::Demo(); });
\ No newline at end of file
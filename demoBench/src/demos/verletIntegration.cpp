@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace verletIntegrationBench {
+#include "../../../verletIntegration/src/main.cpp"
+}
+
+static RegisterDemo reg("verletIntegration", SCREEN_W/6, SCREEN_H/6, false, []() -> displib::Engine* { return new verletIntegrationBench::Demo(); });
\ No newline at end of file
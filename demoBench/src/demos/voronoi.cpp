@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace voronoiBench {
+#include "../../../voronoi/src/main.cpp"
+}
+
+static RegisterDemo reg("voronoi", SCREEN_W/8, SCREEN_H/8, false, []() -> displib::Engine* { return new voronoiBench::Demo(); });
\ No newline at end of file
@@ -0,0 +1,7 @@
+#include "../Harness.h"
+
+namespace wheresMyWaterBench {
+#include "../../../wheresMyWater/src/main.cpp"
+}
+
+static RegisterDemo reg("wheresMyWater", SCREEN_W/6, SCREEN_H/6, false, []() -> displib::Engine* { return new wheresMyWaterBench::Demo(); });
\ No newline at end of file
@@ -0,0 +1,131 @@
+//runs every demo headless for a fixed number of frames with a fixed seed and dt, then reports
+//update, draw and present times and allocations per frame for each, optionally as json too.
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include "Harness.h"
+using namespace displib;
+
+//every allocation in the process goes through here to be counted
+static std::atomic<long long> allocCount(0);
+
+void* operator new(size_t n) {
+	allocCount++;
+	void* p=malloc(n?n:1);
+	if (!p) throw std::bad_alloc();
+	return p;
+}
+
+void operator delete(void* p) noexcept {
+	free(p);
+}
+
+//spread of one number over every frame
+struct Spread {
+	double mean=0, p50=0, p95=0, max=0;
+
+	Spread() {}
+
+	Spread(std::vector<double> vals) {
+		if (vals.empty()) return;
+		std::sort(vals.begin(), vals.end());
+		for (double v:vals) mean+=v;
+		mean/=vals.size();
+		p50=vals[vals.size()/2];
+		p95=vals[vals.size()*95/100];
+		max=vals.back();
+	}
+};
+
+struct DemoResult {
+	const DemoEntry* entry;
+	Spread updateMs, drawMs, presentMs, allocs;
+};
+
+void writeSpread(FILE* file, const char* name, const Spread& s, bool last) {
+	fprintf(file, "\"%s\": {\"mean\": %.6g, \"p50\": %.6g, \"p95\": %.6g, \"max\": %.6g}%s", name, s.mean, s.p50, s.p95, s.max, last?"":", ");
+}
+
+bool writeJSON(const char* path, const std::vector<DemoResult>& results, int frames, float dt, unsigned seed) {
+	FILE* file=fopen(path, "w");
+	if (!file) return false;
+	fprintf(file, "{\n  \"suite\": \"demoBench\",\n  \"version\": 1,\n  \"frames\": %d,\n  \"dt\": %.6g,\n  \"seed\": %u,\n  \"results\": [\n", frames, dt, seed);
+	for (size_t i=0; i<results.size(); i++) {
+		const DemoResult& r=results[i];
+		fprintf(file, "    {\"name\": \"%s\", \"w\": %d, \"h\": %d, ", r.entry->name.c_str(), r.entry->w, r.entry->h);
+		writeSpread(file, "updateMs", r.updateMs, false);
+		writeSpread(file, "drawMs", r.drawMs, false);
+		writeSpread(file, "presentMs", r.presentMs, false);
+		writeSpread(file, "allocsPerFrame", r.allocs, true);
+		fprintf(file, "}%s\n", i+1<results.size()?",":"");
+	}
+	fprintf(file, "  ]\n}\n");
+	fclose(file);
+	return true;
+}
+
+int main(int argc, char** argv) {
+	int frames=300;
+	float dt=1/60.f;
+	unsigned seed=1;
+	std::string filter;
+	const char* jsonPath=nullptr;
+	for (int i=1; i<argc; i++) {
+		std::string arg=argv[i];
+		if (arg=="--frames"&&i+1<argc) frames=atoi(argv[++i]);
+		else if (arg=="--dt"&&i+1<argc) dt=(float)atof(argv[++i]);
+		else if (arg=="--seed"&&i+1<argc) seed=(unsigned)atoi(argv[++i]);
+		else if (arg=="--filter"&&i+1<argc) filter=argv[++i];
+		else if (arg=="--json"&&i+1<argc) jsonPath=argv[++i];
+		else {
+			printf("usage: demoBench [--frames n] [--dt secs] [--seed n] [--filter name] [--json path]\n");
+			return 1;
+		}
+	}
+
+	printf("%d frames, dt %.4f, seed %u\n", frames, dt, seed);
+	printf("%-22s %9s | %8s %8s %8s | %8s %8s %8s | %8s | %9s %7s\n", "demo", "size", "upd avg", "upd p95", "upd max", "drw avg", "drw p95", "drw max", "prs avg", "allocs/f", "max");
+
+	//sorted so the report order never depends on link order
+	std::vector<DemoEntry> demos=demoList();
+	std::sort(demos.begin(), demos.end(), [](const DemoEntry& a, const DemoEntry& b) { return a.name<b.name; });
+
+	std::vector<DemoResult> results;
+	results.reserve(demos.size());
+	double totalUpdate=0, totalDraw=0, totalPresent=0;
+	for (const DemoEntry& d:demos) {
+		if (!filter.empty()&&d.name.find(filter)==std::string::npos) continue;
+
+		Random::seed(seed);
+		Engine* demo=d.make();
+		demo->halfBlocks=d.halfBlocks;
+		std::vector<Engine::FrameStats> stats=demo->startHeadless(d.w, d.h, frames, dt, [] { return allocCount.load(); });
+		delete demo;
+
+		std::vector<double> upd, drw, prs, allocs;
+		for (const Engine::FrameStats& f:stats) {
+			upd.push_back(f.updateMs);
+			drw.push_back(f.drawMs);
+			prs.push_back(f.presentMs);
+			allocs.push_back((double)(f.updateAllocs+f.drawAllocs+f.presentAllocs));
+		}
+		DemoResult r={&d, Spread(upd), Spread(drw), Spread(prs), Spread(allocs)};
+		results.push_back(r);
+		totalUpdate+=r.updateMs.mean;
+		totalDraw+=r.drawMs.mean;
+		totalPresent+=r.presentMs.mean;
+
+		std::string size=std::to_string(d.w)+"x"+std::to_string(d.h);
+		printf("%-22s %9s | %8.3f %8.3f %8.3f | %8.3f %8.3f %8.3f | %8.3f | %9.1f %7.0f\n", d.name.c_str(), size.c_str(),
+			r.updateMs.mean, r.updateMs.p95, r.updateMs.max, r.drawMs.mean, r.drawMs.p95, r.drawMs.max, r.presentMs.mean, r.allocs.mean, r.allocs.max);
+	}
+	printf("%d demos, mean frame sum: update %.3f ms, draw %.3f ms, present %.3f ms\n", (int)results.size(), totalUpdate, totalDraw, totalPresent);
+
+	if (jsonPath&&!writeJSON(jsonPath, results, frames, dt, seed)) {
+		printf("couldnt write %s\n", jsonPath);
+		return 1;
+	}
+	return 0;
+}
\ No newline at end of file
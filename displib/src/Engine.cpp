@@ -1,11 +1,20 @@
 #include "Engine.h"
 
 namespace displib {
+	bool Engine::headless=false;
+
 	Engine::Engine() {
 		this->raster=Raster();
 		this->windowRect={0, 0, 1, 1};
-		this->consoleHandle=CreateConsoleScreenBuffer(GENERIC_READ|GENERIC_WRITE, 0, NULL, CONSOLE_TEXTMODE_BUFFER, NULL);
 		this->windowHandle=GetConsoleWindow();
+	}
+
+	Engine::~Engine() {
+		if (this->consoleHandle!=INVALID_HANDLE_VALUE) CloseHandle(this->consoleHandle);
+	}
+
+	void Engine::createConsole() {
+		this->consoleHandle=CreateConsoleScreenBuffer(GENERIC_READ|GENERIC_WRITE, 0, NULL, CONSOLE_TEXTMODE_BUFFER, NULL);
 
 		//prevent user from resizing window
 		SetWindowLong(this->windowHandle, GWL_STYLE, GetWindowLong(this->windowHandle, GWL_STYLE)&~WS_MAXIMIZEBOX&~WS_SIZEBOX);
@@ -13,7 +22,8 @@ namespace displib {
 
 	void Engine::start() {
 		//raster setup
-		this->raster=Raster(this->width, this->height);
+		this->raster=Raster(this->width, this->height, this->halfBlocks);
+		COORD bufferSize={(short)this->width, (short)(this->halfBlocks?this->height/2:this->height)};
 
 		//timing
 		this->lastCallTime=std::chrono::system_clock::now();
@@ -21,7 +31,11 @@ namespace displib {
 		//MAIN
 		this->setup();
 
+		bool metricsKey=false, dumpKey=false;
 		while (!this->getKey(VK_ESCAPE)) {
+			//last frame's overlapped tasks may still be going
+			this->tasks.wait();
+
 			//timing
 			std::chrono::duration<float> elapsedTime=std::chrono::system_clock::now()-this->lastCallTime;
 			this->lastCallTime=std::chrono::system_clock::now();
@@ -32,26 +46,43 @@ namespace displib {
 			GetCursorPos(&pt);
 			ScreenToClient(this->windowHandle, &pt);
 			this->mouseX=pt.x/this->charSize;
-			this->mouseY=pt.y/this->charSize;
+			this->mouseY=this->halfBlocks?pt.y*2/this->charSize:pt.y/this->charSize;
 
 			//update
 			this->update(dt);
+			this->tasks.run(dt);
 
 			//ease of use
 			this->framesPerSecond=1/dt;
 			this->updateCount++;
 			this->totalDeltaTime+=dt;
 
-			//draws
+			//draws, alongside whatever doesnt touch what it reads
+			this->tasks.runOverlapped(dt);
 			this->draw(this->raster);
 
+			//gather this frame's numbers
+			Metrics::endFrame();
+			bool key=this->getKey(VK_F3);
+			if (key&&!metricsKey) this->showMetrics=!this->showMetrics;
+			metricsKey=key;
+			key=this->getKey(VK_F4);
+			if (key&&!dumpKey) {
+				Metrics::writePrometheus("metrics.prom");
+				Metrics::writeCSV("metrics.csv");
+			}
+			dumpKey=key;
+			if (this->showMetrics) Metrics::drawOverlay(this->raster, 0, 0);
+
 			//show chars to screen
-			WriteConsoleOutput(this->consoleHandle, this->raster.getBuffer(), {(short)this->width, (short)this->height}, {0, 0}, &windowRect);
+			WriteConsoleOutput(this->consoleHandle, this->raster.getOutput(), bufferSize, {0, 0}, &windowRect);
 		}
+		this->tasks.wait();
 	}
 
 	void Engine::startFullscreen(int cz) {
 		this->charSize=cz;
+		this->createConsole();
 
 		//set console handle
 		SetConsoleActiveScreenBuffer(this->consoleHandle);
@@ -77,12 +108,16 @@ namespace displib {
 		this->height=(csbi.srWindow.Bottom-csbi.srWindow.Top)+1;
 		this->windowRect={0, 0, (short)(this->width-1), (short)(this->height-1)};
 
+		//every char holds two pixels
+		if (this->halfBlocks) this->height*=2;
+
 		//actually start the thing
 		this->start();
 	}
 
 	void Engine::startWindowed(int cz, int w, int h) {
 		this->charSize=cz;
+		this->createConsole();
 		this->width=w;
 		this->height=h;
 
@@ -134,19 +169,84 @@ namespace displib {
 		this->windowRect={0, 0, (short)(this->width-1), (short)(this->height-1)};
 		SetConsoleWindowInfo(this->consoleHandle, TRUE, &this->windowRect);
 
+		//every char holds two pixels
+		if (this->halfBlocks) this->height*=2;
+
 		//actually start the thing
 		this->start();
 	}
 
+	std::vector<Engine::FrameStats> Engine::startHeadless(int w, int h, int frames, float dt, std::function<long long()> countAllocs) {
+		headless=true;
+		this->width=w;
+		this->height=h;
+		this->raster=Raster(this->width, this->height, this->halfBlocks);
+
+		//mouse parked in the middle
+		this->mouseX=this->width/2;
+		this->mouseY=this->height/2;
+
+		this->setup();
+
+		std::vector<FrameStats> stats(frames);
+		auto allocs=[&] { return countAllocs?countAllocs():0; };
+		for (int i=0; i<frames; i++) {
+			FrameStats& f=stats[i];
+			long long a0=allocs();
+			auto t0=std::chrono::steady_clock::now();
+			this->tasks.wait();
+			this->update(dt);
+			this->tasks.run(dt);
+			auto t1=std::chrono::steady_clock::now();
+			long long a1=allocs();
+
+			this->framesPerSecond=1/dt;
+			this->updateCount++;
+			this->totalDeltaTime+=dt;
+
+			auto t2=std::chrono::steady_clock::now();
+			this->tasks.runOverlapped(dt);
+			this->draw(this->raster);
+			auto t3=std::chrono::steady_clock::now();
+			long long a2=allocs();
+			Metrics::endFrame();
+
+			//the output packing is part of a real frame too, only the console write is left out
+			long long a3=allocs();
+			auto t4=std::chrono::steady_clock::now();
+			this->raster.getOutput();
+			auto t5=std::chrono::steady_clock::now();
+			long long a4=allocs();
+
+			f.updateMs=std::chrono::duration<float, std::milli>(t1-t0).count();
+			f.drawMs=std::chrono::duration<float, std::milli>(t3-t2).count();
+			f.presentMs=std::chrono::duration<float, std::milli>(t5-t4).count();
+			f.updateAllocs=a1-a0;
+			f.drawAllocs=a2-a1;
+			f.presentAllocs=a4-a3;
+		}
+
+		this->tasks.wait();
+		headless=false;
+		return stats;
+	}
+
 	void Engine::setup() {}
 
 	void Engine::update(float dt) {}
 
 	void Engine::draw(Raster& rst) {}
 
-	bool Engine::getKey(int k) { return GetAsyncKeyState(k); }
+	void Engine::addTask(std::string name, TaskGraph::Func func, std::vector<std::string> deps, bool overlapDraw) {
+		this->tasks.add(name, func, deps, overlapDraw);
+	}
+
+	bool Engine::getKey(int k) { return !headless&&GetAsyncKeyState(k); }
 
 	HWND& Engine::getWindowHandle() { return this->windowHandle; }
 
-	void Engine::setTitle(std::string str) { SetConsoleTitleA(str.c_str()); }
+	void Engine::setTitle(std::string str) {
+		if (headless) return;
+		SetConsoleTitleA(str.c_str());
+	}
 }
\ No newline at end of file
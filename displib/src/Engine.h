@@ -1,12 +1,17 @@
+#include "io/Metrics.h"
 #include "io/Raster.h"
+#include "TaskGraph.h"
 #include <chrono>
+#include <functional>
+#include <vector>
 
 namespace displib {
 #pragma once
 	class Engine {
 		private:
 		Raster raster;
-		HANDLE consoleHandle;
+		//only made once started on screen, headless runs never touch the console
+		HANDLE consoleHandle=INVALID_HANDLE_VALUE;
 		HWND windowHandle;
 		SMALL_RECT windowRect;
 		int charSize=0;
@@ -14,25 +19,52 @@ namespace displib {
 
 		void start();
 
+		//new screen buffer, and a window the user cant resize
+		void createConsole();
+
 		public:
+		//numbers for one frame of startHeadless, present is packing the raster for output.
+		struct FrameStats {
+			float updateMs, drawMs, presentMs;
+			long long updateAllocs, drawAllocs, presentAllocs;
+		};
+
+		//set while running headless, keys read as up and popups and titles are skipped.
+		static bool headless;
+
 		int width=0, height=0;
+		//set before starting to pack two pixels into every console char, doubling height.
+		bool halfBlocks=false;
 		int updateCount=0;
 		int mouseX=0, mouseY=0;
 		float framesPerSecond=0, totalDeltaTime=0;
 
+		//run every frame after update, see addTask.
+		TaskGraph tasks;
+
+		//F3 flips this to draw the metrics over the frame, F4 writes them to metrics.prom and metrics.csv.
+		bool showMetrics=false;
+
 		//displays windows box for a message
 		static void showPopupBox(std::string title, std::string content) {
+			if (headless) return;
 			MessageBoxA(0, content.c_str(), title.c_str(), MB_OK);
 		}
 		
 		Engine();
 
+		virtual ~Engine();
+
 		//new fullscreen console with specific square sized chars
 		void startFullscreen(int cz);
 
 		//new console window with specific square sized chars, sized accordingly.
 		void startWindowed(int cz, int w, int h);
 
+		//runs setup then a fixed number of frames with a fixed dt into a raster that is never shown, no console needed.
+		//countAllocs, if given, returns a running allocation count to diff around update and draw.
+		std::vector<FrameStats> startHeadless(int w, int h, int frames, float dt, std::function<long long()> countAllocs=nullptr);
+
 		//this is called at the start of the program, must extend it.
 		virtual void setup();
 
@@ -42,12 +74,17 @@ namespace displib {
 		//this is called as fast as possible, giving the raster in which to draw/render on, must extend it.
 		virtual void draw(Raster& rst);
 
+		//registers a task run every frame after update, once every task named in deps has finished.
+		//overlapDraw tasks run during draw instead, so they must not touch anything draw reads.
+		//register from setup, so the task captures the engine that is actually running.
+		void addTask(std::string name, TaskGraph::Func func, std::vector<std::string> deps={}, bool overlapDraw=false);
+
 		//is this key pressed?
 		bool getKey(int k);
 
 		HWND& getWindowHandle();
 
-		//set console title.
+		//set console title, skipped when headless.
 		void setTitle(std::string str);
 	};
 }
\ No newline at end of file
@@ -0,0 +1,250 @@
+#include "TaskGraph.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "maths/Random.h"
+
+namespace displib {
+	TaskGraph::TaskGraph(const TaskGraph& o) {
+		*this=o;
+	}
+
+	TaskGraph& TaskGraph::operator=(const TaskGraph& o) {
+		if (this==&o) return *this;
+
+		this->wait();
+		this->tasks.clear();
+		for (const Task& t:o.tasks) this->add(t.name, t.func, t.deps, t.overlapDraw);
+		return *this;
+	}
+
+	TaskGraph::~TaskGraph() {
+		this->wait();
+		this->stopWorkers();
+	}
+
+	void TaskGraph::add(std::string name, Func func, std::vector<std::string> deps, bool overlapDraw) {
+		Task t;
+		t.name=name;
+		t.func=func;
+		t.deps=deps;
+		t.overlapDraw=overlapDraw;
+		this->tasks.push_back(t);
+		this->dirty=true;
+	}
+
+	void TaskGraph::remove(std::string name) {
+		this->wait();
+		for (int i=this->tasks.size()-1; i>=0; i--) {
+			if (this->tasks[i].name==name) this->tasks.erase(this->tasks.begin()+i);
+		}
+		this->dirty=true;
+	}
+
+	void TaskGraph::clear() {
+		this->wait();
+		this->tasks.clear();
+		this->dirty=true;
+	}
+
+	bool TaskGraph::empty() const {
+		return this->tasks.empty();
+	}
+
+	void TaskGraph::build() {
+		int n=this->tasks.size();
+		for (Task& t:this->tasks) {
+			t.dependents.clear();
+			t.depCount=0;
+		}
+
+		for (int i=0; i<n; i++) {
+			Task& t=this->tasks[i];
+			for (const std::string& d:t.deps) {
+				int j=0;
+				while (j<n&&this->tasks[j].name!=d) j++;
+				if (j==n) {
+					printf("task %s depends on missing task %s. ending execution.", t.name.c_str(), d.c_str());
+					exit(1);
+				}
+
+				//other phase is always done by the time this one starts
+				if (this->tasks[j].overlapDraw!=t.overlapDraw) continue;
+				this->tasks[j].dependents.push_back(i);
+				t.depCount++;
+			}
+		}
+
+		//kahns, anything never freed is on a cycle
+		std::vector<int> left(n), ready;
+		for (int i=0; i<n; i++) {
+			left[i]=this->tasks[i].depCount;
+			if (!left[i]) ready.push_back(i);
+		}
+		int freed=0;
+		while (!ready.empty()) {
+			int i=ready.back();
+			ready.pop_back();
+			freed++;
+			for (int d:this->tasks[i].dependents) if (!--left[d]) ready.push_back(d);
+		}
+		if (freed!=n) {
+			printf("task graph has a dependency cycle. ending execution.");
+			exit(1);
+		}
+
+		this->waiting.assign(n, 0);
+		this->dirty=false;
+	}
+
+	void TaskGraph::startWorkers() {
+		if (!this->workers.empty()) return;
+
+		//this thread helps, so one less
+		int num=(int)std::thread::hardware_concurrency()-1;
+		for (int i=0; i<num; i++) {
+			this->workers.emplace_back([this, i] {
+				//a stream per slot, the same one every run
+				Random::setLocalStream(i+1);
+				std::unique_lock<std::mutex> lock(this->mtx);
+				while (true) {
+					this->cv.wait(lock, [this] { return this->stopping||!this->queue.empty(); });
+					if (this->queue.empty()) return;
+
+					std::function<void()> job=std::move(this->queue.front());
+					this->queue.pop_front();
+					lock.unlock();
+					job();
+					lock.lock();
+				}
+			});
+		}
+	}
+
+	void TaskGraph::stopWorkers() {
+		{
+			std::lock_guard<std::mutex> lock(this->mtx);
+			this->stopping=true;
+		}
+		this->cv.notify_all();
+		for (std::thread& w:this->workers) w.join();
+		this->workers.clear();
+		this->stopping=false;
+	}
+
+	void TaskGraph::launch(bool overlapped, float dt) {
+		if (this->dirty) this->build();
+		this->startWorkers();
+
+		std::lock_guard<std::mutex> lock(this->mtx);
+		for (int i=0; i<(int)this->tasks.size(); i++) {
+			const Task& t=this->tasks[i];
+			if (t.overlapDraw!=overlapped) continue;
+
+			this->pending++;
+			this->waiting[i]=t.depCount;
+			if (!t.depCount) this->queue.push_back([this, i, dt] { this->execute(i, dt); });
+		}
+		this->cv.notify_all();
+	}
+
+	void TaskGraph::execute(int i, float dt) {
+		Task& t=this->tasks[i];
+		auto start=std::chrono::steady_clock::now();
+		t.func(dt);
+		t.ms=std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now()-start).count();
+
+		{
+			std::lock_guard<std::mutex> lock(this->mtx);
+			for (int d:t.dependents) {
+				if (!--this->waiting[d]) this->queue.push_back([this, d, dt] { this->execute(d, dt); });
+			}
+			this->pending--;
+		}
+		this->cv.notify_all();
+	}
+
+	void TaskGraph::helpUntilDone() {
+		std::unique_lock<std::mutex> lock(this->mtx);
+		while (this->pending>0) {
+			if (this->queue.empty()) {
+				this->cv.wait(lock);
+				continue;
+			}
+
+			std::function<void()> job=std::move(this->queue.front());
+			this->queue.pop_front();
+			lock.unlock();
+			job();
+			lock.lock();
+		}
+	}
+
+	void TaskGraph::run(float dt) {
+		//last frame's overlapped tasks first
+		this->wait();
+		if (this->tasks.empty()) return;
+
+		this->launch(false, dt);
+		this->helpUntilDone();
+	}
+
+	void TaskGraph::runOverlapped(float dt) {
+		if (this->tasks.empty()) return;
+
+		this->launch(true, dt);
+	}
+
+	void TaskGraph::wait() {
+		this->helpUntilDone();
+	}
+
+	void TaskGraph::parallelFor(int n, std::function<void(int)> func) {
+		if (n<=0) return;
+		this->startWorkers();
+		if (this->workers.empty()||n==1) {
+			for (int i=0; i<n; i++) func(i);
+			return;
+		}
+
+		//helpers may start after this returns, so they share ownership
+		struct Shared {
+			std::atomic<int> next{0}, done{0};
+			int n;
+			std::function<void(int)> func;
+		};
+		auto s=std::make_shared<Shared>();
+		s->n=n;
+		s->func=func;
+		auto work=[this, s] {
+			int i;
+			while ((i=s->next++)<s->n) {
+				s->func(i);
+				if (++s->done==s->n) {
+					std::lock_guard<std::mutex> lock(this->mtx);
+					this->cv.notify_all();
+				}
+			}
+		};
+
+		{
+			std::lock_guard<std::mutex> lock(this->mtx);
+			int helpers=std::min((int)this->workers.size(), n-1);
+			for (int i=0; i<helpers; i++) this->queue.push_back(work);
+		}
+		this->cv.notify_all();
+
+		//take indices here too, then wait on any still running
+		work();
+		std::unique_lock<std::mutex> lock(this->mtx);
+		this->cv.wait(lock, [&] { return s->done==n; });
+	}
+
+	float TaskGraph::getMs(std::string name) const {
+		for (const Task& t:this->tasks) if (t.name==name) return t.ms;
+		return -1;
+	}
+}
\ No newline at end of file
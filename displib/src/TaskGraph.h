@@ -0,0 +1,94 @@
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace displib {
+#pragma once
+	//named per-frame tasks with dependencies, spread over a pool of worker threads.
+	//a task starts once every task it depends on has finished this frame.
+	class TaskGraph {
+		public:
+		typedef std::function<void(float)> Func;
+
+		private:
+		struct Task {
+			std::string name;
+			Func func;
+			std::vector<std::string> deps;
+			bool overlapDraw=false;
+
+			//found on build, only tasks of the same phase count
+			std::vector<int> dependents;
+			int depCount=0;
+			float ms=0;
+		};
+
+		std::vector<Task> tasks;
+		bool dirty=false;
+
+		//deps left per task this phase, guarded by mtx
+		std::vector<int> waiting;
+		int pending=0;
+
+		std::vector<std::thread> workers;
+		std::deque<std::function<void()>> queue;
+		std::mutex mtx;
+		std::condition_variable cv;
+		bool stopping=false;
+
+		void build();
+
+		void startWorkers();
+
+		void stopWorkers();
+
+		//queues the roots of one phase
+		void launch(bool overlapped, float dt);
+
+		void execute(int i, float dt);
+
+		//runs queued jobs on this thread until the phase is done
+		void helpUntilDone();
+
+		public:
+		TaskGraph() {}
+
+		//copies the tasks, never the threads.
+		TaskGraph(const TaskGraph& o);
+
+		TaskGraph& operator=(const TaskGraph& o);
+
+		~TaskGraph();
+
+		//overlapDraw tasks run alongside draw and finish before the next frame,
+		//so they must not touch anything draw reads. a normal task depending on one sees last frame's result.
+		void add(std::string name, Func func, std::vector<std::string> deps={}, bool overlapDraw=false);
+
+		void remove(std::string name);
+
+		void clear();
+
+		bool empty() const;
+
+		//runs every normal task, returns once all have finished.
+		void run(float dt);
+
+		//starts the overlapDraw tasks and returns straight away.
+		void runOverlapped(float dt);
+
+		//blocks until the overlapDraw tasks are done, helping with them.
+		void wait();
+
+		//calls func for 0 to n-1 split over the pool, from update or from inside a task.
+		void parallelFor(int n, std::function<void(int)> func);
+
+		//how long the task took last frame, -1 if there is no such task.
+		float getMs(std::string name) const;
+	};
+}
\ No newline at end of file
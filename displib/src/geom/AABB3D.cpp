@@ -29,4 +29,48 @@ namespace displib {
 		bool zOverlap=this->min.z<=aabb.max.z&&this->max.z>=aabb.min.z;
 		return xOverlap&&yOverlap&&zOverlap;
 	}
+
+	AABB3D AABB3D::empty() {
+		return AABB3D(float3(INFINITY), float3(-INFINITY));
+	}
+
+	void AABB3D::expand(float3 pt) {
+		this->min=float3(fminf(this->min.x, pt.x), fminf(this->min.y, pt.y), fminf(this->min.z, pt.z));
+		this->max=float3(fmaxf(this->max.x, pt.x), fmaxf(this->max.y, pt.y), fmaxf(this->max.z, pt.z));
+	}
+
+	void AABB3D::expand(AABB3D aabb) {
+		this->expand(aabb.min);
+		this->expand(aabb.max);
+	}
+
+	float3 AABB3D::getCenter() const {
+		return (this->min+this->max)*0.5f;
+	}
+
+	float AABB3D::getSurfaceArea() const {
+		float3 d=this->max-this->min;
+		return 2*(d.x*d.y+d.y*d.z+d.z*d.x);
+	}
+
+	bool AABB3D::intersectRay(float3 origin, float3 invDir, float tMax, float* tNear) const {
+		float3 t0=(this->min-origin)*invDir;
+		float3 t1=(this->max-origin)*invDir;
+		float nx=fminf(t0.x, t1.x), ny=fminf(t0.y, t1.y), nz=fminf(t0.z, t1.z);
+		float fx=fmaxf(t0.x, t1.x), fy=fmaxf(t0.y, t1.y), fz=fmaxf(t0.z, t1.z);
+		float tn=fmaxf(fmaxf(nx, ny), fmaxf(nz, 0.f));
+		float tf=fminf(fminf(fx, fy), fminf(fz, tMax));
+		*tNear=tn;
+		return tn<=tf;
+	}
+
+	//min and max pick the second operand on nan, so a 0*inf slab never decides a hit alone
+	int AABB3D::intersectRays8(const float3x8& origin, const float3x8& invDir, const floatx8& tMax, floatx8& tNear) const {
+		float3x8 t0=(float3x8(this->min)-origin)*invDir;
+		float3x8 t1=(float3x8(this->max)-origin)*invDir;
+		floatx8 tn=vmax(vmax(vmin(t0.x, t1.x), vmin(t0.y, t1.y)), vmax(vmin(t0.z, t1.z), floatx8()));
+		floatx8 tf=vmin(vmin(vmax(t0.x, t1.x), vmax(t0.y, t1.y)), vmin(vmax(t0.z, t1.z), tMax));
+		tNear=tn;
+		return moveMask(tn<=tf);
+	}
 }
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "../maths/vector/float3.h"
+#include "../maths/vector/float3x8.h"
 
 namespace displib {
 #pragma once
@@ -17,5 +18,23 @@ namespace displib {
 
 		//rectangle bool overlap
 		bool overlapAABB(AABB3D aabb);
+
+		//inside out box, anything expanded into it replaces it.
+		static AABB3D empty();
+
+		//grow to fit pt or box
+		void expand(float3 pt);
+		void expand(AABB3D aabb);
+
+		float3 getCenter() const;
+
+		//sum of face areas, the sah cost of a box.
+		float getSurfaceArea() const;
+
+		//slab test, invDir is 1/dir. tNear is where the ray enters, clamped to 0.
+		bool intersectRay(float3 origin, float3 invDir, float tMax, float* tNear) const;
+
+		//same slab test for a packet of 8 rays, bit i set if ray i hits.
+		int intersectRays8(const float3x8& origin, const float3x8& invDir, const floatx8& tMax, floatx8& tNear) const;
 	};
 }
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include "AABBArray.h"
+
+#include <cmath>
+
+namespace displib {
+	//calls func(base+j) for each set bit j
+	template<class F>
+	static inline void forEachBit(int mask, int base, const F& func) {
+		for (int j=0; mask; j++, mask>>=1) {
+			if (mask&1) func(base+j);
+		}
+	}
+
+	void AABB2DArray::resize(int n) {
+		int padded=(n+7)&~7;
+		this->minXs.resize(padded);
+		this->minYs.resize(padded);
+		this->maxXs.resize(padded);
+		this->maxYs.resize(padded);
+		//anything past the old size is made inside out, including padding left by a shrink
+		for (int i=this->count<n?this->count:n; i<padded; i++) {
+			this->minXs[i]=this->minYs[i]=INFINITY;
+			this->maxXs[i]=this->maxYs[i]=-INFINITY;
+		}
+		this->count=n;
+	}
+
+	void AABB2DArray::queryAABB(const AABB2D& b, std::function<void(int)> func) const {
+		int padded=this->paddedSize();
+		int i=0;
+		//16 at a time, the two tests are independent
+		for (; i+16<=padded; i+=16) {
+			int mask=this->overlap8(i, b)|(this->overlap8(i+8, b)<<8);
+			if (mask) forEachBit(mask, i, func);
+		}
+		if (i<padded) forEachBit(this->overlap8(i, b), i, func);
+	}
+
+	void AABB2DArray::forEachPair(std::function<void(int, int)> func) const {
+		int padded=this->paddedSize();
+		for (int a=0; a<this->count; a++) {
+			AABB2D b=this->get(a);
+			auto emit=[&](int other) { func(a, other); };
+
+			//first batch has lanes at or below a masked off
+			int i=(a+1)&~7;
+			if (i<padded) {
+				int mask=this->overlap8(i, b)&~((1<<(a+1-i))-1);
+				if (mask) forEachBit(mask, i, emit);
+				i+=8;
+			}
+			for (; i+16<=padded; i+=16) {
+				int mask=this->overlap8(i, b)|(this->overlap8(i+8, b)<<8);
+				if (mask) forEachBit(mask, i, emit);
+			}
+			if (i<padded) forEachBit(this->overlap8(i, b), i, emit);
+		}
+	}
+
+	void AABB3DArray::resize(int n) {
+		int padded=(n+7)&~7;
+		this->minXs.resize(padded);
+		this->minYs.resize(padded);
+		this->minZs.resize(padded);
+		this->maxXs.resize(padded);
+		this->maxYs.resize(padded);
+		this->maxZs.resize(padded);
+		//anything past the old size is made inside out, including padding left by a shrink
+		for (int i=this->count<n?this->count:n; i<padded; i++) {
+			this->minXs[i]=this->minYs[i]=this->minZs[i]=INFINITY;
+			this->maxXs[i]=this->maxYs[i]=this->maxZs[i]=-INFINITY;
+		}
+		this->count=n;
+	}
+
+	int AABB3DArray::intersectRay8(int i, float3 origin, float3 invDir, float tMax, floatx8& tNear) const {
+		floatx8 ox(origin.x), oy(origin.y), oz(origin.z);
+		floatx8 ix(invDir.x), iy(invDir.y), iz(invDir.z);
+		floatx8 x0=(floatx8::load(&this->minXs[i])-ox)*ix, x1=(floatx8::load(&this->maxXs[i])-ox)*ix;
+		floatx8 y0=(floatx8::load(&this->minYs[i])-oy)*iy, y1=(floatx8::load(&this->maxYs[i])-oy)*iy;
+		floatx8 z0=(floatx8::load(&this->minZs[i])-oz)*iz, z1=(floatx8::load(&this->maxZs[i])-oz)*iz;
+		floatx8 tn=vmax(vmax(vmin(x0, x1), vmin(y0, y1)), vmax(vmin(z0, z1), floatx8()));
+		floatx8 tf=vmin(vmin(vmax(x0, x1), vmax(y0, y1)), vmin(vmax(z0, z1), floatx8(tMax)));
+		tNear=tn;
+		//the slabs of an inside out box still give a hit, so those are masked off
+		floatx8 valid=floatx8::load(&this->minXs[i])<=floatx8::load(&this->maxXs[i]);
+		return moveMask((tn<=tf)&valid);
+	}
+
+	void AABB3DArray::queryAABB(const AABB3D& b, std::function<void(int)> func) const {
+		int padded=this->paddedSize();
+		int i=0;
+		//16 at a time, the two tests are independent
+		for (; i+16<=padded; i+=16) {
+			int mask=this->overlap8(i, b)|(this->overlap8(i+8, b)<<8);
+			if (mask) forEachBit(mask, i, func);
+		}
+		if (i<padded) forEachBit(this->overlap8(i, b), i, func);
+	}
+
+	void AABB3DArray::forEachPair(std::function<void(int, int)> func) const {
+		int padded=this->paddedSize();
+		for (int a=0; a<this->count; a++) {
+			AABB3D b=this->get(a);
+			auto emit=[&](int other) { func(a, other); };
+
+			//first batch has lanes at or below a masked off
+			int i=(a+1)&~7;
+			if (i<padded) {
+				int mask=this->overlap8(i, b)&~((1<<(a+1-i))-1);
+				if (mask) forEachBit(mask, i, emit);
+				i+=8;
+			}
+			for (; i+16<=padded; i+=16) {
+				int mask=this->overlap8(i, b)|(this->overlap8(i+8, b)<<8);
+				if (mask) forEachBit(mask, i, emit);
+			}
+			if (i<padded) forEachBit(this->overlap8(i, b), i, emit);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include <functional>
+#include <vector>
+
+#include "AABB2D.h"
+#include "AABB3D.h"
+
+namespace displib {
+#pragma once
+	//AABB2Ds stored as one array per component, for testing one box against 8 at a time.
+	//storage is padded to a multiple of 8 with inside out boxes, which never overlap or contain anything.
+	class AABB2DArray {
+		private:
+		std::vector<float> minXs, minYs, maxXs, maxYs;
+		int count=0;
+
+		public:
+		AABB2DArray() {}
+
+		AABB2DArray(int n) { this->resize(n); }
+
+		int size() const { return this->count; }
+
+		//size rounded up to whole batches.
+		int paddedSize() const { return (int)this->minXs.size(); }
+
+		//new elements are inside out.
+		void resize(int n);
+
+		void push_back(const AABB2D& b) {
+			this->resize(this->count+1);
+			this->set(this->count-1, b);
+		}
+
+		AABB2D get(int i) const { return AABB2D(this->minXs[i], this->minYs[i], this->maxXs[i], this->maxYs[i]); }
+
+		void set(int i, const AABB2D& b) {
+			this->minXs[i]=b.min.x; this->minYs[i]=b.min.y;
+			this->maxXs[i]=b.max.x; this->maxYs[i]=b.max.y;
+		}
+
+		//box around a circle.
+		void setCircle(int i, float2 ctr, float rad) {
+			this->minXs[i]=ctr.x-rad; this->minYs[i]=ctr.y-rad;
+			this->maxXs[i]=ctr.x+rad; this->maxYs[i]=ctr.y+rad;
+		}
+
+		//bit j set if box i+j overlaps b, i should be a multiple of 8.
+		int overlap8(int i, const AABB2D& b) const {
+			floatx8 x=floatx8::load(&this->minXs[i])<=floatx8(b.max.x);
+			floatx8 y=floatx8::load(&this->minYs[i])<=floatx8(b.max.y);
+			floatx8 z=floatx8::load(&this->maxXs[i])>=floatx8(b.min.x);
+			floatx8 w=floatx8::load(&this->maxYs[i])>=floatx8(b.min.y);
+			return moveMask(x&y&z&w);
+		}
+
+		//bit j set if box i+j contains pt, i should be a multiple of 8.
+		int containsPt8(int i, float2 pt) const {
+			return this->overlap8(i, AABB2D(pt, pt));
+		}
+
+		//calls func for every box overlapping b.
+		void queryAABB(const AABB2D& b, std::function<void(int)> func) const;
+
+		//calls func once for every overlapping pair, lower index first.
+		void forEachPair(std::function<void(int, int)> func) const;
+	};
+
+	//AABB3Ds stored as one array per component, for testing one box or ray against 8 at a time.
+	//storage is padded to a multiple of 8 with inside out boxes, which never overlap or get hit.
+	class AABB3DArray {
+		private:
+		std::vector<float> minXs, minYs, minZs, maxXs, maxYs, maxZs;
+		int count=0;
+
+		public:
+		AABB3DArray() {}
+
+		AABB3DArray(int n) { this->resize(n); }
+
+		int size() const { return this->count; }
+
+		//size rounded up to whole batches.
+		int paddedSize() const { return (int)this->minXs.size(); }
+
+		//new elements are inside out.
+		void resize(int n);
+
+		void push_back(const AABB3D& b) {
+			this->resize(this->count+1);
+			this->set(this->count-1, b);
+		}
+
+		AABB3D get(int i) const { return AABB3D(this->minXs[i], this->minYs[i], this->minZs[i], this->maxXs[i], this->maxYs[i], this->maxZs[i]); }
+
+		void set(int i, const AABB3D& b) {
+			this->minXs[i]=b.min.x; this->minYs[i]=b.min.y; this->minZs[i]=b.min.z;
+			this->maxXs[i]=b.max.x; this->maxYs[i]=b.max.y; this->maxZs[i]=b.max.z;
+		}
+
+		//bit j set if box i+j overlaps b, i should be a multiple of 8.
+		int overlap8(int i, const AABB3D& b) const {
+			floatx8 lo=(floatx8::load(&this->minXs[i])<=floatx8(b.max.x))&(floatx8::load(&this->minYs[i])<=floatx8(b.max.y))&(floatx8::load(&this->minZs[i])<=floatx8(b.max.z));
+			floatx8 hi=(floatx8::load(&this->maxXs[i])>=floatx8(b.min.x))&(floatx8::load(&this->maxYs[i])>=floatx8(b.min.y))&(floatx8::load(&this->maxZs[i])>=floatx8(b.min.z));
+			return moveMask(lo&hi);
+		}
+
+		//slab test of one ray against boxes i to i+7, invDir is 1/dir. i should be a multiple of 8.
+		//bit j set if box i+j is hit before tMax, tNear gets where the ray enters each, clamped to 0.
+		int intersectRay8(int i, float3 origin, float3 invDir, float tMax, floatx8& tNear) const;
+
+		//calls func for every box overlapping b.
+		void queryAABB(const AABB3D& b, std::function<void(int)> func) const;
+
+		//calls func once for every overlapping pair, lower index first.
+		void forEachPair(std::function<void(int, int)> func) const;
+	};
+}
@@ -0,0 +1,341 @@
+#include "BVH.h"
+
+#include <utility>
+
+namespace displib {
+	//sah bins per split, more is slower to build and barely better to trace
+	static const int BIN_NUM=12;
+
+	//deep enough for any tree built from an int count of prims
+	static const int STACK_SIZE=64;
+
+	BVH::BVH() {}
+
+	//inline grow, the AABB3D ones are out of line and this is the hot loop of the build
+	static inline void grow(AABB3D& a, float3 mn, float3 mx) {
+		a.min=float3(mn.x<a.min.x?mn.x:a.min.x, mn.y<a.min.y?mn.y:a.min.y, mn.z<a.min.z?mn.z:a.min.z);
+		a.max=float3(mx.x>a.max.x?mx.x:a.max.x, mx.y>a.max.y?mx.y:a.max.y, mx.z>a.max.z?mx.z:a.max.z);
+	}
+
+	//inline slab test, same as AABB3D::intersectRay
+	static inline bool slab(const AABB3D& b, float3 origin, float3 invDir, float tMax, float* tNear) {
+		float3 t0=(b.min-origin)*invDir;
+		float3 t1=(b.max-origin)*invDir;
+		float nx=t0.x<t1.x?t0.x:t1.x, ny=t0.y<t1.y?t0.y:t1.y, nz=t0.z<t1.z?t0.z:t1.z;
+		float fx=t0.x>t1.x?t0.x:t1.x, fy=t0.y>t1.y?t0.y:t1.y, fz=t0.z>t1.z?t0.z:t1.z;
+		float tn=nx>ny?nx:ny;
+		tn=nz>tn?nz:tn;
+		tn=tn>0?tn:0;
+		float tf=fx<fy?fx:fy;
+		tf=fz<tf?fz:tf;
+		tf=tMax<tf?tMax:tf;
+		*tNear=tn;
+		return tn<=tf;
+	}
+
+	void BVH::build(const AABB3D* boxes, int n, int maxLeafSize) {
+		this->nodes.clear();
+		this->prims.resize(n);
+		if (n==0) return;
+		this->nodes.reserve(n/maxLeafSize*2+1);
+
+		//box, center and index together, partitioned in place so the build reads memory in order
+		struct Ref {
+			AABB3D box;
+			float3 center;
+			int prim;
+		};
+		std::vector<Ref> refs(n);
+		AABB3D rootBounds=AABB3D::empty();
+		for (int i=0; i<n; i++) {
+			refs[i]={boxes[i], boxes[i].getCenter(), i};
+			grow(rootBounds, boxes[i].min, boxes[i].max);
+		}
+
+		//range of refs, made into a node when popped so nodes come out depth first.
+		//a left child is always popped straight after its parent, a right child tells its parent where it went.
+		struct Task {
+			int parent;
+			bool right;
+			int start, end, depth;
+			AABB3D bounds;
+		};
+		std::vector<Task> tasks;
+		tasks.push_back({-1, false, 0, n, 0, rootBounds});
+
+		while (!tasks.empty()) {
+			Task t=tasks.back();
+			tasks.pop_back();
+
+			int nodeIx=(int)this->nodes.size();
+			this->nodes.push_back(Node());
+			if (t.right) this->nodes[t.parent].start=nodeIx;
+			this->nodes[nodeIx].bounds=t.bounds;
+
+			int count=t.end-t.start;
+			auto makeLeaf=[&] {
+				this->nodes[nodeIx].start=t.start;
+				this->nodes[nodeIx].count=count;
+			};
+			//too deep for the trace stack
+			if (count<=maxLeafSize||t.depth>=STACK_SIZE-1) { makeLeaf(); continue; }
+
+			//split along widest spread of centers
+			AABB3D centerBounds=AABB3D::empty();
+			for (int i=t.start; i<t.end; i++) grow(centerBounds, refs[i].center, refs[i].center);
+			float3 ext=centerBounds.max-centerBounds.min;
+			int axis=ext.x>ext.y&&ext.x>ext.z?0:(ext.y>ext.z?1:2);
+			float lo=(&centerBounds.min.x)[axis];
+			float width=(&ext.x)[axis];
+			if (width<=0) { makeLeaf(); continue; }
+
+			//bin the refs
+			AABB3D binBounds[BIN_NUM];
+			int binCounts[BIN_NUM]={0};
+			for (int b=0; b<BIN_NUM; b++) binBounds[b]=AABB3D::empty();
+			float scale=BIN_NUM/width;
+			auto binOf=[&](const Ref& r) {
+				int b=(int)(((&r.center.x)[axis]-lo)*scale);
+				return b<BIN_NUM-1?b:BIN_NUM-1;
+			};
+			for (int i=t.start; i<t.end; i++) {
+				int b=binOf(refs[i]);
+				binCounts[b]++;
+				grow(binBounds[b], refs[i].box.min, refs[i].box.max);
+			}
+
+			//sweep from the right for suffix boxes, then from the left for the cheapest split
+			AABB3D rightBounds[BIN_NUM];
+			int rightCount[BIN_NUM];
+			AABB3D acc=AABB3D::empty();
+			int accCount=0;
+			for (int b=BIN_NUM-1; b>0; b--) {
+				grow(acc, binBounds[b].min, binBounds[b].max);
+				accCount+=binCounts[b];
+				rightBounds[b]=acc;
+				rightCount[b]=accCount;
+			}
+			float bestCost=INFINITY;
+			int bestSplit=-1;
+			AABB3D bestLeft;
+			acc=AABB3D::empty();
+			accCount=0;
+			for (int b=1; b<BIN_NUM; b++) {
+				grow(acc, binBounds[b-1].min, binBounds[b-1].max);
+				accCount+=binCounts[b-1];
+				if (accCount==0||rightCount[b]==0) continue;
+				float cost=acc.getSurfaceArea()*accCount+rightBounds[b].getSurfaceArea()*rightCount[b];
+				if (cost<bestCost) {
+					bestCost=cost;
+					bestSplit=b;
+					bestLeft=acc;
+				}
+			}
+
+			//splitting has to beat one big leaf, unless the leaf would be too big
+			float leafCost=t.bounds.getSurfaceArea()*count;
+			bool worthIt=bestSplit!=-1&&bestCost<leafCost;
+			if (!worthIt&&count<=maxLeafSize*4) { makeLeaf(); continue; }
+
+			int mid=t.start;
+			AABB3D leftBounds, rgtBounds;
+			if (bestSplit!=-1) {
+				for (int i=t.start; i<t.end; i++) {
+					if (binOf(refs[i])<bestSplit) std::swap(refs[i], refs[mid++]);
+				}
+				leftBounds=bestLeft;
+				rgtBounds=rightBounds[bestSplit];
+			}
+			else {
+				//all in one bin, halve by order
+				mid=t.start+count/2;
+				leftBounds=rgtBounds=AABB3D::empty();
+				for (int i=t.start; i<mid; i++) grow(leftBounds, refs[i].box.min, refs[i].box.max);
+				for (int i=mid; i<t.end; i++) grow(rgtBounds, refs[i].box.min, refs[i].box.max);
+			}
+
+			//inner node, right child index is filled in when it is made
+			this->nodes[nodeIx].count=0;
+			tasks.push_back({nodeIx, true, mid, t.end, t.depth+1, rgtBounds});
+			tasks.push_back({nodeIx, false, t.start, mid, t.depth+1, leftBounds});
+		}
+
+		for (int i=0; i<n; i++) this->prims[i]=refs[i].prim;
+	}
+
+	void BVH::refit(const AABB3D* boxes) {
+		//children always come after parents
+		for (int i=(int)this->nodes.size()-1; i>=0; i--) {
+			Node& node=this->nodes[i];
+			AABB3D b=AABB3D::empty();
+			if (node.count>0) {
+				for (int p=node.start; p<node.start+node.count; p++) grow(b, boxes[this->prims[p]].min, boxes[this->prims[p]].max);
+			}
+			else {
+				grow(b, this->nodes[i+1].bounds.min, this->nodes[i+1].bounds.max);
+				grow(b, this->nodes[node.start].bounds.min, this->nodes[node.start].bounds.max);
+			}
+			node.bounds=b;
+		}
+	}
+
+	float BVH::traceRay(float3 origin, float3 dir, float tMax, std::function<float(int, float)> hitFunc) const {
+		return this->traceLeaves(origin, dir, tMax, [&](int start, int count, float tMax) {
+			for (int p=start; p<start+count; p++) {
+				float t=hitFunc(this->prims[p], tMax);
+				if (t<tMax) tMax=t;
+			}
+			return tMax;
+		});
+	}
+
+	bool BVH::occluded(float3 origin, float3 dir, float tMax, std::function<bool(int, float)> hitFunc) const {
+		return this->occludedLeaves(origin, dir, tMax, [&](int start, int count, float tMax) {
+			for (int p=start; p<start+count; p++) {
+				if (hitFunc(this->prims[p], tMax)) return true;
+			}
+			return false;
+		});
+	}
+
+	float BVH::traceLeaves(float3 origin, float3 dir, float tMax, std::function<float(int, int, float)> leafFunc) const {
+		if (this->nodes.empty()) return tMax;
+		float3 invDir=float3(1)/dir;
+
+		float tNear;
+		if (!slab(this->nodes[0].bounds, origin, invDir, tMax, &tNear)) return tMax;
+
+		int stack[STACK_SIZE];
+		int top=0;
+		stack[top++]=0;
+		while (top>0) {
+			const Node& node=this->nodes[stack[--top]];
+
+			if (node.count>0) {
+				float t=leafFunc(node.start, node.count, tMax);
+				if (t<tMax) tMax=t;
+				continue;
+			}
+
+			//push the far child first so the near one is walked first
+			int a=(int)(&node-this->nodes.data())+1, b=node.start;
+			float ta, tb;
+			bool hitA=slab(this->nodes[a].bounds, origin, invDir, tMax, &ta);
+			bool hitB=slab(this->nodes[b].bounds, origin, invDir, tMax, &tb);
+			if (hitA&&hitB) {
+				if (ta>tb) std::swap(a, b);
+				stack[top++]=b;
+				stack[top++]=a;
+			}
+			else if (hitA) stack[top++]=a;
+			else if (hitB) stack[top++]=b;
+		}
+		return tMax;
+	}
+
+	bool BVH::occludedLeaves(float3 origin, float3 dir, float tMax, std::function<bool(int, int, float)> leafFunc) const {
+		if (this->nodes.empty()) return false;
+		float3 invDir=float3(1)/dir;
+
+		//order doesnt matter when any hit ends it, so no sorting children
+		float tNear;
+		int stack[STACK_SIZE];
+		int top=0;
+		stack[top++]=0;
+		while (top>0) {
+			int i=stack[--top];
+			const Node& node=this->nodes[i];
+			if (!slab(node.bounds, origin, invDir, tMax, &tNear)) continue;
+
+			if (node.count>0) {
+				if (leafFunc(node.start, node.count, tMax)) return true;
+			}
+			else {
+				stack[top++]=node.start;
+				stack[top++]=i+1;
+			}
+		}
+		return false;
+	}
+
+	void BVH::traceLeaves8(const float3x8& origin, const float3x8& dir, floatx8& tMax, int mask, std::function<void(int, int, int)> leafFunc) const {
+		if (this->nodes.empty()||!mask) return;
+		float3x8 invDir=float3x8(floatx8(1))/dir;
+
+		//children are walked in the order the first live ray would meet them
+		int lead=0;
+		while (!(mask>>lead&1)) lead++;
+		float3 leadDir=dir[lead];
+
+		floatx8 tNear;
+		int stack[STACK_SIZE];
+		int top=0;
+		stack[top++]=0;
+		while (top>0) {
+			int i=stack[--top];
+			const Node& node=this->nodes[i];
+
+			//tested on pop, tMax may have dropped since it was pushed
+			int live=node.bounds.intersectRays8(origin, invDir, tMax, tNear)&mask;
+			if (!live) continue;
+
+			if (node.count>0) {
+				leafFunc(node.start, node.count, live);
+				continue;
+			}
+
+			int a=i+1, b=node.start;
+			if (dot(leadDir, this->nodes[b].bounds.getCenter()-this->nodes[a].bounds.getCenter())<0) std::swap(a, b);
+			stack[top++]=b;
+			stack[top++]=a;
+		}
+	}
+
+	int BVH::occludedLeaves8(const float3x8& origin, const float3x8& dir, const floatx8& tMax, int mask, std::function<int(int, int, int)> leafFunc) const {
+		if (this->nodes.empty()||!mask) return 0;
+		float3x8 invDir=float3x8(floatx8(1))/dir;
+
+		int blocked=0;
+		floatx8 tNear;
+		int stack[STACK_SIZE];
+		int top=0;
+		stack[top++]=0;
+		while (top>0) {
+			int i=stack[--top];
+			const Node& node=this->nodes[i];
+			int live=node.bounds.intersectRays8(origin, invDir, tMax, tNear)&mask&~blocked;
+			if (!live) continue;
+
+			if (node.count>0) {
+				blocked|=leafFunc(node.start, node.count, live)&live;
+				if (blocked==mask) break;
+			}
+			else {
+				stack[top++]=node.start;
+				stack[top++]=i+1;
+			}
+		}
+		return blocked;
+	}
+
+	void BVH::queryAABB(AABB3D aabb, std::function<void(int)> func) const {
+		if (this->nodes.empty()) return;
+
+		int stack[STACK_SIZE];
+		int top=0;
+		stack[top++]=0;
+		while (top>0) {
+			int i=stack[--top];
+			const Node& node=this->nodes[i];
+			if (!aabb.overlapAABB(node.bounds)) continue;
+
+			if (node.count>0) {
+				for (int p=node.start; p<node.start+node.count; p++) func(this->prims[p]);
+			}
+			else {
+				stack[top++]=node.start;
+				stack[top++]=i+1;
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include <functional>
+#include <vector>
+
+#include "AABB3D.h"
+
+namespace displib {
+#pragma once
+	//bounding volume hierarchy over any primitives given as boxes.
+	//nodes live flat in depth first order, so the left child is always the next node.
+	class BVH {
+		public:
+		struct Node {
+			AABB3D bounds;
+
+			//leaves hold prims[start] to prims[start+count], inner nodes have count 0 and start is the right child.
+			int start=0, count=0;
+		};
+
+		std::vector<Node> nodes;
+
+		//primitive indices, ordered so each leaf's are together.
+		std::vector<int> prims;
+
+		BVH();
+
+		//binned surface area heuristic build, one box per primitive.
+		void build(const AABB3D* boxes, int n, int maxLeafSize=4);
+
+		//refits every node bottom up for moved primitives, the tree shape is kept.
+		//fast, but the tree gets worse the further things move from where it was built.
+		void refit(const AABB3D* boxes);
+
+		//walks leaves along the ray nearest first. hitFunc(prim, tMax) returns the hit distance, or tMax for a miss.
+		//returns the closest hit, tMax if nothing.
+		float traceRay(float3 origin, float3 dir, float tMax, std::function<float(int, float)> hitFunc) const;
+
+		//any hit will do, for shadow rays. stops at the first prim hitFunc says is hit before tMax.
+		bool occluded(float3 origin, float3 dir, float tMax, std::function<bool(int, float)> hitFunc) const;
+
+		//same walks a leaf at a time, leafFunc(start, count, tMax) gets prims[start] to prims[start+count].
+		//for primitives stored in prims order, so one leaf is one run of them.
+		float traceLeaves(float3 origin, float3 dir, float tMax, std::function<float(int, int, float)> leafFunc) const;
+		bool occludedLeaves(float3 origin, float3 dir, float tMax, std::function<bool(int, int, float)> leafFunc) const;
+
+		//packet of 8 rays walked together, lanes not set in mask are left out.
+		//leafFunc(start, count, lanes) gets the lanes that reached the leaf and lowers their tMax on a hit.
+		void traceLeaves8(const float3x8& origin, const float3x8& dir, floatx8& tMax, int mask, std::function<void(int, int, int)> leafFunc) const;
+
+		//leafFunc returns which of its lanes are blocked, those drop out. returns every blocked lane.
+		int occludedLeaves8(const float3x8& origin, const float3x8& dir, const floatx8& tMax, int mask, std::function<int(int, int, int)> leafFunc) const;
+
+		//calls func for every primitive whose box overlaps aabb.
+		void queryAABB(AABB3D aabb, std::function<void(int)> func) const;
+	};
+}
@@ -0,0 +1,128 @@
+#include "Camera3D.h"
+
+#include "../TaskGraph.h"
+#include "../maths/vector/float3x8.h"
+
+namespace displib {
+	const unsigned char Camera3D::OFF_LEFT, Camera3D::OFF_RIGHT, Camera3D::OFF_TOP, Camera3D::OFF_BOTTOM, Camera3D::BEHIND;
+	const unsigned char Camera3D::BACKFACE, Camera3D::OFFSCREEN;
+
+	//below this the pool costs more than it saves
+	static const int THREAD_MIN=1<<15;
+
+	//points per pool job, whole batches of 8
+	static const int CHUNK=1<<12;
+
+	Camera3D::Camera3D() {
+		this->setOrbit(0, 0, 1, 1, float2());
+	}
+
+	void Camera3D::setOrbit(float yaw, float pitch, float dist, float zoom_, float2 center_) {
+		float sy=sinf(yaw), cy=cosf(yaw);
+		float sp=sinf(pitch), cp=cosf(pitch);
+
+		this->right=float3(sy, 0, -cy);
+		this->up=float3(cy*cp, sp, sy*cp);
+		//right cross up, so screen winding matches facing
+		float3 back(cy*sp, -cp, sy*sp);
+		this->forward=back*-1;
+		this->pos=back*dist;
+
+		this->zoom=zoom_;
+		this->center=center_;
+	}
+
+	void Camera3D::setScreen(float w, float h) {
+		this->screenW=w;
+		this->screenH=h;
+	}
+
+	float2 Camera3D::project(float3 v) const {
+		return float2(dot(v, this->right), dot(v, this->up))*this->zoom+this->center;
+	}
+
+	float Camera3D::depth(float3 v) const {
+		return dot(v-this->pos, this->forward);
+	}
+
+	void Camera3D::projectBatch(const float3* in, float2* out, float* depth, int n) const {
+		this->projectBatch(in, out, depth, nullptr, n);
+	}
+
+	void Camera3D::projectBatch(const float3* in, float2* out, float* depth, unsigned char* clip, int n) const {
+		auto run=[=](int start, int end) {
+			float3x8 r(this->right), u(this->up), f(this->forward);
+			floatx8 z(this->zoom), cx(this->center.x), cy(this->center.y);
+			floatx8 d(-dot(this->pos, this->forward));
+			floatx8 zero, w(this->screenW), h(this->screenH);
+			bool checkScreen=this->screenW>0&&this->screenH>0;
+
+			float xs[8], ys[8], zs[8];
+			float sxs[8], sys[8];
+			for (int i=start; i<end; i+=8) {
+				int m=end-i<8?end-i:8;
+
+				//aos to soa
+				for (int k=0; k<m; k++) {
+					xs[k]=in[i+k].x;
+					ys[k]=in[i+k].y;
+					zs[k]=in[i+k].z;
+				}
+				float3x8 v=float3x8::loadPartial(xs, ys, zs, m);
+
+				floatx8 sx=dot(v, r)*z+cx;
+				floatx8 sy=dot(v, u)*z+cy;
+				floatx8 dp=dot(v, f)+d;
+				sx.store(sxs);
+				sy.store(sys);
+				for (int k=0; k<m; k++) out[i+k]=float2(sxs[k], sys[k]);
+				if (depth) dp.storePartial(depth+i, m);
+
+				if (clip) {
+					int behind=moveMask(dp<zero);
+					int left=0, rgt=0, top=0, bottom=0;
+					if (checkScreen) {
+						left=moveMask(sx<zero);
+						rgt=moveMask(sx>=w);
+						top=moveMask(sy<zero);
+						bottom=moveMask(sy>=h);
+					}
+					for (int k=0; k<m; k++) {
+						clip[i+k]=(unsigned char)(
+							((left>>k)&1)*OFF_LEFT|
+							((rgt>>k)&1)*OFF_RIGHT|
+							((top>>k)&1)*OFF_TOP|
+							((bottom>>k)&1)*OFF_BOTTOM|
+							((behind>>k)&1)*BEHIND
+						);
+					}
+				}
+			}
+		};
+
+		if (!this->pool||n<THREAD_MIN) {
+			run(0, n);
+			return;
+		}
+
+		this->pool->parallelFor((n+CHUNK-1)/CHUNK, [&](int c) {
+			int start=c*CHUNK;
+			run(start, n-start<CHUNK?n:start+CHUNK);
+		});
+	}
+
+	void Camera3D::classifyTris(const float2* pts, const unsigned char* clip, const int* ids, unsigned char* flags, int n) {
+		for (int i=0; i<n; i++) {
+			int a=ids[i*3], b=ids[i*3+1], c=ids[i*3+2];
+			unsigned char f=0;
+			if (!Camera3D::isFrontFacing(pts[a], pts[b], pts[c])) f|=BACKFACE;
+			if (clip&&(clip[a]&clip[b]&clip[c])) f|=OFFSCREEN;
+			flags[i]=f;
+		}
+	}
+
+	bool Camera3D::isFrontFacing(float2 a, float2 b, float2 c) {
+		float2 ab=b-a, ac=c-a;
+		return ab.x*ac.y-ab.y*ac.x>0;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#include "../maths/vector/float2.h"
+#include "../maths/vector/float3.h"
+
+namespace displib {
+#pragma once
+	class TaskGraph;
+
+	//orthographic camera orbiting the origin, the view the 3d demos use.
+	//the trig is done once in setOrbit, after that a point is 3 dot prods.
+	class Camera3D {
+		public:
+		//clip flags per point, a tri is off screen if all 3 share a bit.
+		static const unsigned char OFF_LEFT=1, OFF_RIGHT=2, OFF_TOP=4, OFF_BOTTOM=8, BEHIND=16;
+
+		//flags per tri.
+		static const unsigned char BACKFACE=1, OFFSCREEN=2;
+
+		//view rows, screen x, screen y and into the screen.
+		float3 right, up, forward;
+
+		//where the eye sits, dist back from the origin.
+		float3 pos;
+
+		float zoom=1;
+		float2 center;
+
+		//screen size for clip flags.
+		float screenW=0, screenH=0;
+
+		//big batches are split over its workers if set, usually the engine's tasks.
+		TaskGraph* pool=nullptr;
+
+		Camera3D();
+
+		//yaw and pitch in radians, zoom in chars per unit.
+		void setOrbit(float yaw, float pitch, float dist, float zoom_, float2 center_);
+
+		//screen rect used for clip flags.
+		void setScreen(float w, float h);
+
+		//screen position of v.
+		float2 project(float3 v) const;
+
+		//distance of v in front of the eye, along forward.
+		float depth(float3 v) const;
+
+		//projects n points, 8 at a time. depth and clip may be nullptr.
+		void projectBatch(const float3* in, float2* out, float* depth, int n) const;
+		void projectBatch(const float3* in, float2* out, float* depth, unsigned char* clip, int n) const;
+
+		//BACKFACE and OFFSCREEN for n tris of projected points, ids holds 3 indices per tri.
+		static void classifyTris(const float2* pts, const unsigned char* clip, const int* ids, unsigned char* flags, int n);
+
+		//screen winding, true if tri abc faces the camera.
+		static bool isFrontFacing(float2 a, float2 b, float2 c);
+	};
+}
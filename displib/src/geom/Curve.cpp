@@ -0,0 +1,71 @@
+#include "Curve.h"
+
+namespace displib {
+	//past this the pieces are far below a cell anyway
+	static const int MAX_DEPTH=16;
+
+	static void begin(float2 p0, std::vector<float2>& out) {
+		if (out.empty()||out.back().x!=p0.x||out.back().y!=p0.y) out.push_back(p0);
+	}
+
+	//de casteljau halves until flat, appending every end but p0
+	static void subdivide(float2 p0, float2 p1, float2 p2, float2 p3, float tol2x16, int depth, std::vector<float2>& out) {
+		//how far the control points stray from the chord, times 4
+		float2 u=p1*3-p0*2-p3;
+		float2 v=p2*3-p0-p3*2;
+		float ux=u.x*u.x, uy=u.y*u.y, vx=v.x*v.x, vy=v.y*v.y;
+		float flat=(ux>vx?ux:vx)+(uy>vy?uy:vy);
+		if (flat<=tol2x16||depth>=MAX_DEPTH) {
+			out.push_back(p3);
+			return;
+		}
+
+		float2 p01=(p0+p1)*0.5f, p12=(p1+p2)*0.5f, p23=(p2+p3)*0.5f;
+		float2 p012=(p01+p12)*0.5f, p123=(p12+p23)*0.5f;
+		float2 mid=(p012+p123)*0.5f;
+		subdivide(p0, p01, p012, mid, tol2x16, depth+1, out);
+		subdivide(mid, p123, p23, p3, tol2x16, depth+1, out);
+	}
+
+	float2 Curve::quadratic(float2 p0, float2 p1, float2 p2, float t) {
+		float s=1-t;
+		return p0*(s*s)+p1*(2*s*t)+p2*(t*t);
+	}
+
+	float2 Curve::cubic(float2 p0, float2 p1, float2 p2, float2 p3, float t) {
+		float s=1-t;
+		return p0*(s*s*s)+p1*(3*s*s*t)+p2*(3*s*t*t)+p3*(t*t*t);
+	}
+
+	float2 Curve::catmullRom(float2 p0, float2 p1, float2 p2, float2 p3, float t) {
+		float t2=t*t, t3=t2*t;
+		return (p1*2+(p2-p0)*t+(p0*2-p1*5+p2*4-p3)*t2+(p1*3-p0-p2*3+p3)*t3)*0.5f;
+	}
+
+	void Curve::flattenQuadratic(float2 p0, float2 p1, float2 p2, float tol, std::vector<float2>& out) {
+		//same curve as a cubic
+		flattenCubic(p0, p0+(p1-p0)*(2/3.f), p2+(p1-p2)*(2/3.f), p2, tol, out);
+	}
+
+	void Curve::flattenCubic(float2 p0, float2 p1, float2 p2, float2 p3, float tol, std::vector<float2>& out) {
+		begin(p0, out);
+		subdivide(p0, p1, p2, p3, 16*tol*tol, 0, out);
+	}
+
+	void Curve::flattenCatmullRom(float2 p0, float2 p1, float2 p2, float2 p3, float tol, std::vector<float2>& out) {
+		//same span as a bezier
+		flattenCubic(p1, p1+(p2-p0)/6, p2-(p3-p1)/6, p2, tol, out);
+	}
+
+	void Curve::flattenCatmullRom(const float2* pts, int n, float tol, std::vector<float2>& out) {
+		if (n<2) {
+			if (n==1) begin(pts[0], out);
+			return;
+		}
+		for (int i=0; i+1<n; i++) {
+			float2 prev=pts[i>0?i-1:0];
+			float2 next=pts[i+2<n?i+2:n-1];
+			flattenCatmullRom(prev, pts[i], pts[i+1], next, tol, out);
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#include <vector>
+
+#include "../maths/vector/float2.h"
+
+namespace displib {
+#pragma once
+	//bezier and catmull-rom curves, evaluated at a t or flattened to line segments.
+	//flattening splits until each piece is within tol of its chord, so straight runs cost one segment.
+	class Curve {
+		public:
+		static float2 quadratic(float2 p0, float2 p1, float2 p2, float t);
+
+		static float2 cubic(float2 p0, float2 p1, float2 p2, float2 p3, float t);
+
+		//uniform catmull-rom, passes through p1 at t=0 and p2 at t=1.
+		static float2 catmullRom(float2 p0, float2 p1, float2 p2, float2 p3, float t);
+
+		//appends the curve as points to out, leaving off the start if out already ends on it so pieces chain.
+		static void flattenQuadratic(float2 p0, float2 p1, float2 p2, float tol, std::vector<float2>& out);
+
+		static void flattenCubic(float2 p0, float2 p1, float2 p2, float2 p3, float tol, std::vector<float2>& out);
+
+		//the p1 to p2 span.
+		static void flattenCatmullRom(float2 p0, float2 p1, float2 p2, float2 p3, float tol, std::vector<float2>& out);
+
+		//a whole spline through every point, ends use themselves as the outer neighbor.
+		static void flattenCatmullRom(const float2* pts, int n, float tol, std::vector<float2>& out);
+	};
+}
\ No newline at end of file
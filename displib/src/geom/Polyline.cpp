@@ -0,0 +1,65 @@
+#include "Polyline.h"
+
+namespace displib {
+	Polyline::Polyline(int capacity) {
+		this->setCapacity(capacity);
+	}
+
+	void Polyline::setCapacity(int capacity) {
+		if (capacity<0) capacity=0;
+		if (capacity==this->capacity()) return;
+
+		//unwrap the newest that fit, oldest first
+		int keep=this->count<capacity?this->count:capacity;
+		std::vector<float2> next(capacity*2);
+		for (int i=0; i<keep; i++) next[i]=next[i+capacity]=(*this)[this->count-keep+i];
+		this->pts.swap(next);
+		this->head=0;
+		this->count=keep;
+	}
+
+	int Polyline::capacity() const {
+		return this->pts.size()/2;
+	}
+
+	int Polyline::size() const {
+		return this->count;
+	}
+
+	bool Polyline::empty() const {
+		return this->count==0;
+	}
+
+	bool Polyline::full() const {
+		return this->count==this->capacity();
+	}
+
+	void Polyline::clear() {
+		this->head=0;
+		this->count=0;
+	}
+
+	void Polyline::push(float2 p) {
+		int cap=this->capacity();
+		if (!cap) return;
+
+		//head is the oldest, the slot after the newest
+		int at=this->head+this->count;
+		if (at>=cap) at-=cap;
+		this->pts[at]=this->pts[at+cap]=p;
+		if (this->count<cap) this->count++;
+		else if (++this->head==cap) this->head=0;
+	}
+
+	float2 Polyline::operator[](int i) const {
+		return this->pts[this->head+i];
+	}
+
+	const float2* Polyline::data() const {
+		return this->pts.data()+this->head;
+	}
+
+	float2 Polyline::back() const {
+		return (*this)[this->count-1];
+	}
+}
\ No newline at end of file
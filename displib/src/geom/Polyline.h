@@ -0,0 +1,42 @@
+#include <vector>
+
+#include "../maths/vector/float2.h"
+
+namespace displib {
+#pragma once
+	//fixed capacity ring of points, once full each push drops the oldest in O(1). made for trails.
+	class Polyline {
+		private:
+		//every point is stored twice, capacity apart, so the live points never wrap
+		std::vector<float2> pts;
+		int head=0, count=0;
+
+		public:
+		Polyline() {}
+
+		Polyline(int capacity);
+
+		//keeps the newest points that still fit.
+		void setCapacity(int capacity);
+
+		int capacity() const;
+
+		int size() const;
+
+		bool empty() const;
+
+		bool full() const;
+
+		void clear();
+
+		void push(float2 p);
+
+		//0 is the oldest point.
+		float2 operator[](int i) const;
+
+		//size() points in a row, oldest first. moves on the next push.
+		const float2* data() const;
+
+		float2 back() const;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,489 @@
+#include "QuadTree.h"
+
+#include <cmath>
+
+namespace displib {
+	//cells split in 2 this many times per axis at most
+	static const int Q_BITS=16;
+	static const int Q_SIZE=1<<Q_BITS;
+
+	//depth first walks never hold more than 3 siblings per level plus the last 4
+	static const int STACK_SIZE=64;
+
+	//spreads the low 16 bits of v out to the even bits
+	static inline unsigned spreadBits(unsigned v) {
+		v&=0xFFFF;
+		v=(v|(v<<8))&0x00FF00FF;
+		v=(v|(v<<4))&0x0F0F0F0F;
+		v=(v|(v<<2))&0x33333333;
+		v=(v|(v<<1))&0x55555555;
+		return v;
+	}
+
+	//squared distance from pt to a box, 0 inside
+	static inline float distSqToBox(float2 pt, float2 mn, float2 mx) {
+		float dx=mn.x-pt.x>0?mn.x-pt.x:(pt.x-mx.x>0?pt.x-mx.x:0);
+		float dy=mn.y-pt.y>0?mn.y-pt.y:(pt.y-mx.y>0?pt.y-mx.y:0);
+		return dx*dx+dy*dy;
+	}
+
+	QuadTree::QuadTree(AABB2D bounds_, int cap_) {
+		this->bounds=bounds_;
+		float2 size=this->bounds.max-this->bounds.min;
+		this->scale=float2(Q_SIZE/size.x, Q_SIZE/size.y);
+		this->cap=cap_<1?1:cap_;
+		this->clear();
+	}
+
+	void QuadTree::quantize(float2 p, int& qx, int& qy) const {
+		float fx=(p.x-this->bounds.min.x)*this->scale.x;
+		float fy=(p.y-this->bounds.min.y)*this->scale.y;
+		qx=fx<0?0:(fx>=Q_SIZE?Q_SIZE-1:(int)fx);
+		qy=fy<0?0:(fy>=Q_SIZE?Q_SIZE-1:(int)fy);
+	}
+
+	int QuadTree::quadrantOf(int qx, int qy, int depth) {
+		int shift=Q_BITS-1-depth;
+		return ((qx>>shift)&1)|(((qy>>shift)&1)<<1);
+	}
+
+	int QuadTree::allocBucket() {
+		int b;
+		if (!this->freeBuckets.empty()) {
+			b=this->freeBuckets.back();
+			this->freeBuckets.pop_back();
+			this->bucketNext[b]=-1;
+		} else {
+			b=(int)this->bucketNext.size();
+			this->bucketNext.push_back(-1);
+			this->items.resize(this->items.size()+this->cap);
+		}
+		return b;
+	}
+
+	void QuadTree::freeBucketChain(int b) {
+		while (b!=-1) {
+			this->freeBuckets.push_back(b);
+			b=this->bucketNext[b];
+		}
+	}
+
+	int QuadTree::allocGroup(int parent, bool withBuckets) {
+		int g;
+		if (!this->freeGroups.empty()) {
+			g=this->freeGroups.back();
+			this->freeGroups.pop_back();
+		} else {
+			g=(int)this->nodes.size();
+			this->nodes.resize(g+4);
+		}
+
+		Node p=this->nodes[parent];
+		int half=Q_SIZE>>(p.depth+1);
+		for (int i=0; i<4; i++) {
+			Node& c=this->nodes[g+i];
+			c.parent=parent;
+			c.firstChild=-1;
+			c.bucket=-1;
+			c.count=0;
+			c.qx=p.qx+(i&1?half:0);
+			c.qy=p.qy+(i&2?half:0);
+			c.depth=p.depth+1;
+		}
+		if (withBuckets) {
+			for (int i=0; i<4; i++) {
+				int b=this->allocBucket();
+				this->nodes[g+i].bucket=b;
+			}
+		}
+		return g;
+	}
+
+	void QuadTree::pushItem(int node, Item item) {
+		int count=this->nodes[node].count;
+		int slot=count%this->cap;
+		int b=this->nodes[node].bucket;
+		if (slot==0&&count>0) {
+			//full chain, add a bucket on the end
+			while (this->bucketNext[b]!=-1) b=this->bucketNext[b];
+			int nb=this->allocBucket();
+			this->bucketNext[b]=nb;
+			b=nb;
+		} else {
+			for (int i=count/this->cap; i>0; i--) b=this->bucketNext[b];
+		}
+		this->items[b*this->cap+slot]=item;
+		this->nodes[node].count++;
+	}
+
+	void QuadTree::split(int node) {
+		int g=this->allocGroup(node, true);
+		int depth=this->nodes[node].depth;
+		int left=this->nodes[node].count;
+		for (int b=this->nodes[node].bucket; left>0; b=this->bucketNext[b]) {
+			int num=left<this->cap?left:this->cap;
+			for (int i=0; i<num; i++) {
+				Item item=this->items[b*this->cap+i];
+				int qx, qy;
+				this->quantize(item.pos, qx, qy);
+				this->pushItem(g+quadrantOf(qx, qy, depth), item);
+			}
+			left-=num;
+		}
+		this->freeBucketChain(this->nodes[node].bucket);
+		this->nodes[node].bucket=-1;
+		this->nodes[node].firstChild=g;
+	}
+
+	void QuadTree::gather(int node, int into) {
+		int g=this->nodes[node].firstChild;
+		if (g==-1) {
+			int left=this->nodes[node].count;
+			for (int b=this->nodes[node].bucket; left>0; b=this->bucketNext[b]) {
+				int num=left<this->cap?left:this->cap;
+				for (int i=0; i<num; i++) this->pushItem(into, this->items[b*this->cap+i]);
+				left-=num;
+			}
+			this->freeBucketChain(this->nodes[node].bucket);
+			return;
+		}
+
+		for (int i=0; i<4; i++) {
+			this->gather(g+i, into);
+			this->nodes[g+i].depth=-1;
+		}
+		this->freeGroups.push_back(g);
+	}
+
+	void QuadTree::collapse(int node) {
+		int g=this->nodes[node].firstChild;
+		int b=this->allocBucket();
+		Node& n=this->nodes[node];
+		n.firstChild=-1;
+		n.bucket=b;
+		n.count=0;
+		for (int i=0; i<4; i++) {
+			this->gather(g+i, node);
+			this->nodes[g+i].depth=-1;
+		}
+		this->freeGroups.push_back(g);
+	}
+
+	void QuadTree::clear() {
+		this->nodes.clear();
+		this->freeGroups.clear();
+		this->items.clear();
+		this->bucketNext.clear();
+		this->freeBuckets.clear();
+
+		Node root;
+		root.parent=-1;
+		root.firstChild=-1;
+		root.bucket=this->allocBucket();
+		root.count=0;
+		root.qx=root.qy=root.depth=0;
+		this->nodes.push_back(root);
+	}
+
+	void QuadTree::build(const float2* pts, const int* ids, int n) {
+		this->clear();
+		if (n==0) return;
+
+		//codes sorted with their point index, 4 radix passes of 8 bits
+		std::vector<unsigned> codes(n), codesTmp(n);
+		std::vector<int> order(n), orderTmp(n);
+		for (int i=0; i<n; i++) {
+			int qx, qy;
+			this->quantize(pts[i], qx, qy);
+			codes[i]=spreadBits(qx)|(spreadBits(qy)<<1);
+			order[i]=i;
+		}
+		for (int shift=0; shift<32; shift+=8) {
+			int offsets[257]={0};
+			for (int i=0; i<n; i++) offsets[((codes[i]>>shift)&0xFF)+1]++;
+			for (int i=0; i<256; i++) offsets[i+1]+=offsets[i];
+			for (int i=0; i<n; i++) {
+				int dst=offsets[(codes[i]>>shift)&0xFF]++;
+				codesTmp[dst]=codes[i];
+				orderTmp[dst]=order[i];
+			}
+			codes.swap(codesTmp);
+			order.swap(orderTmp);
+		}
+
+		this->nodes.reserve(n/this->cap*2+1);
+		this->items.reserve(n+this->cap);
+		this->buildRange(0, codes.data(), order.data(), pts, ids, 0, n);
+	}
+
+	void QuadTree::buildRange(int node, const unsigned* codes, const int* order, const float2* pts, const int* ids, int start, int end) {
+		int count=end-start;
+		int depth=this->nodes[node].depth;
+		if (count<=this->cap||depth==MAX_DEPTH) {
+			//leaves get their bucket now so buckets come out in morton order
+			if (this->nodes[node].bucket==-1) {
+				int b=this->allocBucket();
+				this->nodes[node].bucket=b;
+			}
+			for (int i=start; i<end; i++) {
+				int ix=order[i];
+				this->pushItem(node, {pts[ix], ids?ids[ix]:ix});
+			}
+			return;
+		}
+
+		this->freeBucketChain(this->nodes[node].bucket);
+		this->nodes[node].bucket=-1;
+		this->nodes[node].count=count;
+		int g=this->allocGroup(node, false);
+		this->nodes[node].firstChild=g;
+
+		//codes are sorted and share every digit above this one, so each quadrant is a run
+		int shift=2*(Q_BITS-1-depth);
+		int i=start;
+		for (int q=0; q<4; q++) {
+			int s=i;
+			while (i<end&&(int)((codes[i]>>shift)&3)==q) i++;
+			this->buildRange(g+q, codes, order, pts, ids, s, i);
+		}
+	}
+
+	void QuadTree::insert(float2 pt, int id) {
+		int qx, qy;
+		this->quantize(pt, qx, qy);
+
+		int node=0;
+		while (true) {
+			Node& n=this->nodes[node];
+			if (n.firstChild!=-1) {
+				n.count++;
+				node=n.firstChild+quadrantOf(qx, qy, n.depth);
+				continue;
+			}
+			if (n.count<this->cap||n.depth==MAX_DEPTH) {
+				this->pushItem(node, {pt, id});
+				return;
+			}
+			this->split(node);
+		}
+	}
+
+	bool QuadTree::remove(float2 pt, int id) {
+		int qx, qy;
+		this->quantize(pt, qx, qy);
+
+		int node=0;
+		while (this->nodes[node].firstChild!=-1) {
+			node=this->nodes[node].firstChild+quadrantOf(qx, qy, this->nodes[node].depth);
+		}
+
+		//find it, then move the last item into its slot
+		Node& n=this->nodes[node];
+		int found=-1, last=-1, lastPrev=-1;
+		int left=n.count;
+		for (int b=n.bucket; left>0; b=this->bucketNext[b]) {
+			int num=left<this->cap?left:this->cap;
+			for (int i=0; i<num; i++) {
+				const Item& item=this->items[b*this->cap+i];
+				if (item.id==id&&item.pos.x==pt.x&&item.pos.y==pt.y) found=b*this->cap+i;
+			}
+			left-=num;
+			if (left==0) last=b*this->cap+num-1;
+			else lastPrev=b;
+		}
+		if (found==-1) return false;
+
+		this->items[found]=this->items[last];
+		n.count--;
+		//last bucket in a chain went empty
+		if (n.count>0&&n.count%this->cap==0) {
+			this->freeBuckets.push_back(this->bucketNext[lastPrev]);
+			this->bucketNext[lastPrev]=-1;
+		}
+
+		//fix counts up the tree, the highest parent that got too empty is merged
+		int merge=-1;
+		for (int p=n.parent; p!=-1; p=this->nodes[p].parent) {
+			this->nodes[p].count--;
+			if (this->nodes[p].count<=this->cap/2) merge=p;
+		}
+		if (merge!=-1) this->collapse(merge);
+		return true;
+	}
+
+	int QuadTree::size() const {
+		return this->nodes[0].count;
+	}
+
+	void QuadTree::queryRange(AABB2D range, std::function<void(float2, int)> func) const {
+		//quantizing is monotonic, so any point in range lands in a cell overlapping these
+		int qx0, qy0, qx1, qy1;
+		this->quantize(range.min, qx0, qy0);
+		this->quantize(range.max, qx1, qy1);
+
+		int stack[STACK_SIZE];
+		int top=0;
+		stack[top++]=0;
+		while (top>0) {
+			const Node& n=this->nodes[stack[--top]];
+			int side=Q_SIZE>>n.depth;
+			if (n.qx>qx1||n.qx+side<=qx0||n.qy>qy1||n.qy+side<=qy0) continue;
+
+			if (n.firstChild!=-1) {
+				for (int i=3; i>=0; i--) stack[top++]=n.firstChild+i;
+				continue;
+			}
+
+			int left=n.count;
+			for (int b=n.bucket; left>0; b=this->bucketNext[b]) {
+				int num=left<this->cap?left:this->cap;
+				const Item* bucket=&this->items[b*this->cap];
+				for (int i=0; i<num; i++) {
+					float2 p=bucket[i].pos;
+					if (p.x>=range.min.x&&p.x<=range.max.x&&p.y>=range.min.y&&p.y<=range.max.y) func(p, bucket[i].id);
+				}
+				left-=num;
+			}
+		}
+	}
+
+	int QuadTree::kNearest(float2 pt, int k, std::function<void(float2, int, float)> func) const {
+		if (k>K_MAX) k=K_MAX;
+		if (k<=0) return 0;
+
+		//max heap of the best so far, on the stack so a query never allocates
+		float heapDist[K_MAX];
+		int heapItem[K_MAX];
+		int found=0;
+
+		//one quantum of slack so rounding never prunes a cell too early
+		float2 quantum(1/this->scale.x, 1/this->scale.y);
+		auto cellDistSq=[&](const Node& n) {
+			int side=Q_SIZE>>n.depth;
+			//edge cells also hold everything clamped in from outside the bounds
+			float2 mn(n.qx==0?-INFINITY:this->bounds.min.x+n.qx*quantum.x-quantum.x, n.qy==0?-INFINITY:this->bounds.min.y+n.qy*quantum.y-quantum.y);
+			float2 mx(n.qx+side==Q_SIZE?INFINITY:this->bounds.min.x+(n.qx+side)*quantum.x+quantum.x, n.qy+side==Q_SIZE?INFINITY:this->bounds.min.y+(n.qy+side)*quantum.y+quantum.y);
+			return distSqToBox(pt, mn, mx);
+		};
+
+		struct Entry {
+			int node;
+			float distSq;
+		};
+		Entry stack[STACK_SIZE];
+		int top=0;
+		stack[top++]={0, 0};
+		while (top>0) {
+			Entry e=stack[--top];
+			if (found==k&&e.distSq>=heapDist[0]) continue;
+			const Node& n=this->nodes[e.node];
+
+			if (n.firstChild!=-1) {
+				//push far to near so the nearest child is walked first
+				Entry kids[4];
+				for (int i=0; i<4; i++) kids[i]={n.firstChild+i, cellDistSq(this->nodes[n.firstChild+i])};
+				for (int i=1; i<4; i++) {
+					Entry t=kids[i];
+					int j=i;
+					for (; j>0&&kids[j-1].distSq<t.distSq; j--) kids[j]=kids[j-1];
+					kids[j]=t;
+				}
+				for (int i=0; i<4; i++) {
+					if (found==k&&kids[i].distSq>=heapDist[0]) continue;
+					if (this->nodes[kids[i].node].count==0) continue;
+					stack[top++]=kids[i];
+				}
+				continue;
+			}
+
+			int left=n.count;
+			for (int b=n.bucket; left>0; b=this->bucketNext[b]) {
+				int num=left<this->cap?left:this->cap;
+				for (int i=0; i<num; i++) {
+					int ix=b*this->cap+i;
+					float2 d=this->items[ix].pos-pt;
+					float dSq=d.x*d.x+d.y*d.y;
+					if (found<k) {
+						//sift up
+						int c=found++;
+						while (c>0&&heapDist[(c-1)/2]<dSq) {
+							heapDist[c]=heapDist[(c-1)/2];
+							heapItem[c]=heapItem[(c-1)/2];
+							c=(c-1)/2;
+						}
+						heapDist[c]=dSq;
+						heapItem[c]=ix;
+					} else if (dSq<heapDist[0]) {
+						//replace the worst and sift down
+						int c=0;
+						while (true) {
+							int l=c*2+1, r=l+1, big=c;
+							float bigDist=dSq;
+							if (l<k&&heapDist[l]>bigDist) big=l, bigDist=heapDist[l];
+							if (r<k&&heapDist[r]>bigDist) big=r;
+							if (big==c) break;
+							heapDist[c]=heapDist[big];
+							heapItem[c]=heapItem[big];
+							c=big;
+						}
+						heapDist[c]=dSq;
+						heapItem[c]=ix;
+					}
+				}
+				left-=num;
+			}
+		}
+
+		//heap to nearest first
+		for (int i=1; i<found; i++) {
+			float d=heapDist[i];
+			int it=heapItem[i];
+			int j=i;
+			for (; j>0&&heapDist[j-1]>d; j--) {
+				heapDist[j]=heapDist[j-1];
+				heapItem[j]=heapItem[j-1];
+			}
+			heapDist[j]=d;
+			heapItem[j]=it;
+		}
+		for (int i=0; i<found; i++) {
+			const Item& item=this->items[heapItem[i]];
+			func(item.pos, item.id, heapDist[i]);
+		}
+		return found;
+	}
+
+	void QuadTree::rebalance() {
+		std::vector<float2> pts;
+		std::vector<int> ids;
+		pts.reserve(this->size());
+		ids.reserve(this->size());
+		for (const Node& n:this->nodes) {
+			if (n.depth==-1||n.firstChild!=-1) continue;
+			int left=n.count;
+			for (int b=n.bucket; left>0; b=this->bucketNext[b]) {
+				int num=left<this->cap?left:this->cap;
+				for (int i=0; i<num; i++) {
+					pts.push_back(this->items[b*this->cap+i].pos);
+					ids.push_back(this->items[b*this->cap+i].id);
+				}
+				left-=num;
+			}
+		}
+		this->build(pts.data(), ids.data(), (int)pts.size());
+	}
+
+	AABB2D QuadTree::cellBounds(const Node& n) const {
+		int side=Q_SIZE>>n.depth;
+		float2 mn(this->bounds.min.x+n.qx/this->scale.x, this->bounds.min.y+n.qy/this->scale.y);
+		float2 mx(this->bounds.min.x+(n.qx+side)/this->scale.x, this->bounds.min.y+(n.qy+side)/this->scale.y);
+		return AABB2D(mn, mx);
+	}
+
+	void QuadTree::render(Raster& gfx) {
+		for (const Node& n:this->nodes) {
+			if (n.depth==-1) continue;
+			this->cellBounds(n).render(gfx);
+		}
+	}
+}
\ No newline at end of file
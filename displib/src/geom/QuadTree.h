@@ -0,0 +1,93 @@
+#include <functional>
+#include <vector>
+
+#include "AABB2D.h"
+
+namespace displib {
+#pragma once
+	//point quadtree with bucketed leaves, nodes and buckets come from pools with free lists.
+	//points are routed by their morton code inside the root bounds, so bulk builds come out in morton order.
+	class QuadTree {
+		public:
+		//16 bits per axis, cells stop splitting here and chain extra buckets instead.
+		static const int MAX_DEPTH=16;
+
+		//most neighbours one kNearest call can return.
+		static const int K_MAX=32;
+
+		private:
+		struct Node {
+			//subtree point count, children are 4 nodes in a row from firstChild.
+			int parent, firstChild, bucket, count;
+
+			//cell corner in quantized coords, side is 65536>>depth. freed nodes have depth -1.
+			int qx, qy, depth;
+		};
+
+		struct Item {
+			float2 pos;
+			int id;
+		};
+
+		AABB2D bounds;
+		float2 scale;
+		int cap;
+
+		std::vector<Node> nodes;
+		std::vector<int> freeGroups;
+
+		//bucket b holds items[b*cap] to items[b*cap+cap], chained only at MAX_DEPTH.
+		std::vector<Item> items;
+		std::vector<int> bucketNext;
+		std::vector<int> freeBuckets;
+
+		void quantize(float2 p, int& qx, int& qy) const;
+		static int quadrantOf(int qx, int qy, int depth);
+
+		int allocBucket();
+		void freeBucketChain(int b);
+		//4 new children of parent, with an empty bucket each unless withBuckets is false.
+		int allocGroup(int parent, bool withBuckets);
+
+		void pushItem(int node, Item item);
+		void split(int node);
+		void collapse(int node);
+
+		//moves every point under node into leaf into, freeing the nodes and buckets on the way.
+		void gather(int node, int into);
+
+		void buildRange(int node, const unsigned* codes, const int* order, const float2* pts, const int* ids, int start, int end);
+
+		//cell as a box in world space.
+		AABB2D cellBounds(const Node& n) const;
+
+		public:
+		//points should fall in bounds, ones outside are clamped to the edge cells.
+		QuadTree(AABB2D bounds_, int cap_=8);
+
+		void clear();
+
+		//replaces everything, sorted by morton code first so buckets are filled in memory order.
+		//ids may be nullptr, then point i gets id i.
+		void build(const float2* pts, const int* ids, int n);
+
+		void insert(float2 pt, int id);
+
+		//removes the point with this position and id, merging cells that get too empty.
+		bool remove(float2 pt, int id);
+
+		int size() const;
+
+		//calls func for every point in range.
+		void queryRange(AABB2D range, std::function<void(float2, int)> func) const;
+
+		//calls func for up to k(max K_MAX) nearest points, nearest first. returns how many.
+		int kNearest(float2 pt, int k, std::function<void(float2, int, float)> func) const;
+
+		//rebuilds from the current points, repacking the pools in morton order.
+		void rebalance();
+
+		//draw every cell to raster.
+		void render(Raster& gfx);
+	};
+}
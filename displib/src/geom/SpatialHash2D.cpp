@@ -0,0 +1,124 @@
+#include "SpatialHash2D.h"
+
+#include <algorithm>
+
+namespace displib {
+	SpatialHash2D::SpatialHash2D(float cellSize_) {
+		this->cellSize=cellSize_;
+		this->invCellSize=1/cellSize_;
+		this->cellStarts.assign(2, 0);
+	}
+
+	int SpatialHash2D::cellOf(float f) const {
+		return (int)floorf(f*this->invCellSize);
+	}
+
+	int SpatialHash2D::bucketOf(int cx, int cy) const {
+		//unsigned so cells left of or above the origin shift without ub
+		return (cx&this->wrapMask)|(int)(((unsigned)cy<<this->wrapBits)&this->mask);
+	}
+
+	void SpatialHash2D::rebuild(const float2* pts, int n) {
+		//about 2 buckets per point keeps collisions rare
+		int tableSize=64;
+		while (tableSize<n*2) tableSize*=2;
+		this->mask=tableSize-1;
+		this->wrapBits=0;
+		while ((2<<(this->wrapBits*2))<=tableSize) this->wrapBits++;
+		this->wrapMask=(1<<this->wrapBits)-1;
+
+		//count per bucket
+		this->cellStarts.assign(tableSize+1, 0);
+		this->buckets.resize(n);
+		for (int i=0; i<n; i++) {
+			int b=this->bucketOf(this->cellOf(pts[i].x), this->cellOf(pts[i].y));
+			this->buckets[i]=b;
+			this->cellStarts[b+1]++;
+		}
+
+		//counts to starts
+		for (int b=0; b<tableSize; b++) this->cellStarts[b+1]+=this->cellStarts[b];
+
+		//scatter, using the next bucket's start as a cursor then shifting back
+		this->entries.resize(n);
+		for (int i=0; i<n; i++) {
+			int b=this->buckets[i];
+			this->entries[this->cellStarts[b]++]={pts[i], i, this->cellOf(pts[i].x), this->cellOf(pts[i].y)};
+		}
+		for (int b=tableSize; b>0; b--) this->cellStarts[b]=this->cellStarts[b-1];
+		this->cellStarts[0]=0;
+
+		//cells sharing a bucket are sorted apart so each is one run, ids stay in order inside it
+		for (int b=0; b<tableSize; b++) {
+			if (this->cellStarts[b+1]-this->cellStarts[b]<2) continue;
+			std::sort(this->entries.begin()+this->cellStarts[b], this->entries.begin()+this->cellStarts[b+1], [](const Entry& a, const Entry& o) {
+				if (a.cy!=o.cy) return a.cy<o.cy;
+				if (a.cx!=o.cx) return a.cx<o.cx;
+				return a.id<o.id;
+			});
+		}
+	}
+
+	int SpatialHash2D::size() const {
+		return (int)this->entries.size();
+	}
+
+	void SpatialHash2D::queryRadius(float2 p, float r, std::function<void(int)> func) const {
+		float rSq=r*r;
+		int nx=this->cellOf(p.x-r), ny=this->cellOf(p.y-r);
+		int mx=this->cellOf(p.x+r), my=this->cellOf(p.y+r);
+		for (int cy=ny; cy<=my; cy++) {
+			for (int cx=nx; cx<=mx; cx++) {
+				int b=this->bucketOf(cx, cy);
+				for (int k=this->cellStarts[b]; k<this->cellStarts[b+1]; k++) {
+					const Entry& e=this->entries[k];
+					//other cells can share a bucket, only take this cell's points
+					if (e.cx!=cx||e.cy!=cy) continue;
+					if (lengthSq(e.pos-p)<=rSq) func(e.id);
+				}
+			}
+		}
+	}
+
+	void SpatialHash2D::forEachPair(float r, std::function<void(int, int)> func) const {
+		float rSq=r*r;
+		int reach=(int)ceilf(r*this->invCellSize);
+		auto emit=[&](const Entry& a, const Entry& b) {
+			if (lengthSq(a.pos-b.pos)>=rSq) return;
+			if (a.id<b.id) func(a.id, b.id);
+			else func(b.id, a.id);
+		};
+		auto sameCell=[](const Entry& e, int cx, int cy) {
+			return e.cx==cx&&e.cy==cy;
+		};
+
+		//cell by cell, each cell meets only the forward half of its neighbours so no pair is seen twice
+		for (int b=0; b<=this->mask; b++) {
+			int e=this->cellStarts[b+1];
+			for (int k=this->cellStarts[b], end; k<e; k=end) {
+				int cx=this->entries[k].cx, cy=this->entries[k].cy;
+				end=k+1;
+				while (end<e&&sameCell(this->entries[end], cx, cy)) end++;
+
+				//inside the cell
+				for (int i=k; i<end; i++) {
+					for (int j=i+1; j<end; j++) emit(this->entries[i], this->entries[j]);
+				}
+
+				//against the neighbours
+				for (int dy=0; dy<=reach; dy++) {
+					for (int dx=-reach; dx<=reach; dx++) {
+						if (dy==0&&dx<=0) continue;
+						int nx=cx+dx, ny=cy+dy;
+						int nb=this->bucketOf(nx, ny);
+						int n=this->cellStarts[nb], ne=this->cellStarts[nb+1];
+						while (n<ne&&!sameCell(this->entries[n], nx, ny)) n++;
+						for (; n<ne&&sameCell(this->entries[n], nx, ny); n++) {
+							for (int i=k; i<end; i++) emit(this->entries[i], this->entries[n]);
+						}
+					}
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
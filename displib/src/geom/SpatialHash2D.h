@@ -0,0 +1,47 @@
+#include <functional>
+#include <vector>
+
+#include "../maths/vector/float2.h"
+
+namespace displib {
+#pragma once
+	//uniform grid broad phase, rebuilt from scratch each frame.
+	//points are counting sorted by hashed cell into one flat array, no per cell vectors.
+	class SpatialHash2D {
+		private:
+		struct Entry {
+			float2 pos;
+			int id;
+			int cx, cy;
+		};
+
+		float cellSize, invCellSize;
+		int mask=0;
+
+		//buckets are the grid wrapped round a square table, so near cells stay near in memory.
+		int wrapBits=0, wrapMask=0;
+
+		//bucket b holds entries[cellStarts[b]] to entries[cellStarts[b+1]].
+		std::vector<int> cellStarts;
+		std::vector<Entry> entries;
+		std::vector<int> buckets;
+
+		int cellOf(float f) const;
+		int bucketOf(int cx, int cy) const;
+
+		public:
+		//cell size near the usual query radius works best.
+		SpatialHash2D(float cellSize_);
+
+		//replaces all points, point i gets id i.
+		void rebuild(const float2* pts, int n);
+
+		int size() const;
+
+		//calls func with the id of every point within r of p.
+		void queryRadius(float2 p, float r, std::function<void(int)> func) const;
+
+		//calls func once for every pair of points closer than r, lower id first.
+		void forEachPair(float r, std::function<void(int, int)> func) const;
+	};
+}
@@ -0,0 +1,129 @@
+#include "SpatialHash3D.h"
+
+#include <algorithm>
+
+namespace displib {
+	SpatialHash3D::SpatialHash3D(float cellSize_) {
+		this->cellSize=cellSize_;
+		this->invCellSize=1/cellSize_;
+		this->cellStarts.assign(2, 0);
+	}
+
+	int SpatialHash3D::cellOf(float f) const {
+		return (int)floorf(f*this->invCellSize);
+	}
+
+	int SpatialHash3D::bucketOf(int cx, int cy, int cz) const {
+		//cz goes through unsigned, shifting a negative int is ub
+		return (cx&this->wrapMask)|((cy&this->wrapMask)<<this->wrapBits)|(int)(((unsigned)cz<<(this->wrapBits*2))&this->mask);
+	}
+
+	void SpatialHash3D::rebuild(const float3* pts, int n) {
+		//about 2 buckets per point keeps collisions rare
+		int tableSize=64;
+		while (tableSize<n*2) tableSize*=2;
+		this->mask=tableSize-1;
+		this->wrapBits=0;
+		while ((2<<(this->wrapBits*3))<=tableSize) this->wrapBits++;
+		this->wrapMask=(1<<this->wrapBits)-1;
+
+		//count per bucket
+		this->cellStarts.assign(tableSize+1, 0);
+		this->buckets.resize(n);
+		for (int i=0; i<n; i++) {
+			int b=this->bucketOf(this->cellOf(pts[i].x), this->cellOf(pts[i].y), this->cellOf(pts[i].z));
+			this->buckets[i]=b;
+			this->cellStarts[b+1]++;
+		}
+
+		//counts to starts
+		for (int b=0; b<tableSize; b++) this->cellStarts[b+1]+=this->cellStarts[b];
+
+		//scatter, using the next bucket's start as a cursor then shifting back
+		this->entries.resize(n);
+		for (int i=0; i<n; i++) {
+			int b=this->buckets[i];
+			this->entries[this->cellStarts[b]++]={pts[i], i, this->cellOf(pts[i].x), this->cellOf(pts[i].y), this->cellOf(pts[i].z)};
+		}
+		for (int b=tableSize; b>0; b--) this->cellStarts[b]=this->cellStarts[b-1];
+		this->cellStarts[0]=0;
+
+		//cells sharing a bucket are sorted apart so each is one run, ids stay in order inside it
+		for (int b=0; b<tableSize; b++) {
+			if (this->cellStarts[b+1]-this->cellStarts[b]<2) continue;
+			std::sort(this->entries.begin()+this->cellStarts[b], this->entries.begin()+this->cellStarts[b+1], [](const Entry& a, const Entry& o) {
+				if (a.cz!=o.cz) return a.cz<o.cz;
+				if (a.cy!=o.cy) return a.cy<o.cy;
+				if (a.cx!=o.cx) return a.cx<o.cx;
+				return a.id<o.id;
+			});
+		}
+	}
+
+	int SpatialHash3D::size() const {
+		return (int)this->entries.size();
+	}
+
+	void SpatialHash3D::queryRadius(float3 p, float r, std::function<void(int)> func) const {
+		float rSq=r*r;
+		int nx=this->cellOf(p.x-r), ny=this->cellOf(p.y-r), nz=this->cellOf(p.z-r);
+		int mx=this->cellOf(p.x+r), my=this->cellOf(p.y+r), mz=this->cellOf(p.z+r);
+		for (int cz=nz; cz<=mz; cz++) {
+			for (int cy=ny; cy<=my; cy++) {
+				for (int cx=nx; cx<=mx; cx++) {
+					int b=this->bucketOf(cx, cy, cz);
+					for (int k=this->cellStarts[b]; k<this->cellStarts[b+1]; k++) {
+						const Entry& e=this->entries[k];
+						//other cells can share a bucket, only take this cell's points
+						if (e.cx!=cx||e.cy!=cy||e.cz!=cz) continue;
+						if (lengthSq(e.pos-p)<=rSq) func(e.id);
+					}
+				}
+			}
+		}
+	}
+
+	void SpatialHash3D::forEachPair(float r, std::function<void(int, int)> func) const {
+		float rSq=r*r;
+		int reach=(int)ceilf(r*this->invCellSize);
+		auto emit=[&](const Entry& a, const Entry& b) {
+			if (lengthSq(a.pos-b.pos)>=rSq) return;
+			if (a.id<b.id) func(a.id, b.id);
+			else func(b.id, a.id);
+		};
+		auto sameCell=[](const Entry& e, int cx, int cy, int cz) {
+			return e.cx==cx&&e.cy==cy&&e.cz==cz;
+		};
+
+		//cell by cell, each cell meets only the forward half of its neighbours so no pair is seen twice
+		for (int b=0; b<=this->mask; b++) {
+			int e=this->cellStarts[b+1];
+			for (int k=this->cellStarts[b], end; k<e; k=end) {
+				int cx=this->entries[k].cx, cy=this->entries[k].cy, cz=this->entries[k].cz;
+				end=k+1;
+				while (end<e&&sameCell(this->entries[end], cx, cy, cz)) end++;
+
+				//inside the cell
+				for (int i=k; i<end; i++) {
+					for (int j=i+1; j<end; j++) emit(this->entries[i], this->entries[j]);
+				}
+
+				//against the neighbours
+				for (int dz=0; dz<=reach; dz++) {
+					for (int dy=-reach; dy<=reach; dy++) {
+						for (int dx=-reach; dx<=reach; dx++) {
+							if (dz==0&&(dy<0||(dy==0&&dx<=0))) continue;
+							int nx=cx+dx, ny=cy+dy, nz=cz+dz;
+							int nb=this->bucketOf(nx, ny, nz);
+							int n=this->cellStarts[nb], ne=this->cellStarts[nb+1];
+							while (n<ne&&!sameCell(this->entries[n], nx, ny, nz)) n++;
+							for (; n<ne&&sameCell(this->entries[n], nx, ny, nz); n++) {
+								for (int i=k; i<end; i++) emit(this->entries[i], this->entries[n]);
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
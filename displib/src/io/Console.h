@@ -0,0 +1,18 @@
+#pragma once
+
+#ifdef _WIN32
+#define _WIN32_WINNT 0x0500
+
+#include <windows.h>
+#else
+//headless builds get just the console cell types the raster draws into, laid out the same.
+typedef unsigned short WORD;
+
+typedef struct _CHAR_INFO {
+	union {
+		unsigned short UnicodeChar;
+		char AsciiChar;
+	} Char;
+	WORD Attributes;
+} CHAR_INFO;
+#endif
@@ -0,0 +1,236 @@
+#include "Metrics.h"
+#include "Raster.h"
+
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <mutex>
+
+namespace displib {
+	//running sums one thread has written, only it ever stores to them
+	struct MetricSlot {
+		std::atomic<double> sum;
+		std::atomic<uint64_t> count;
+		std::atomic<uint64_t> buckets[Metrics::BUCKETS];
+	};
+
+	struct ThreadSlots {
+		MetricSlot slots[Metrics::MAX];
+
+		ThreadSlots() {
+			for (MetricSlot& s:this->slots) {
+				s.sum.store(0, std::memory_order_relaxed);
+				s.count.store(0, std::memory_order_relaxed);
+				for (auto& b:s.buckets) b.store(0, std::memory_order_relaxed);
+			}
+		}
+	};
+
+	//guards registration and the thread list, never taken by add/set/observe
+	static std::mutex registryMtx;
+	static std::vector<ThreadSlots*> threadSlots;
+	static std::vector<Metrics::Value> registered;
+	static std::atomic<double> gauges[Metrics::MAX];
+
+	//totals as of the last endFrame, to take frame differences from
+	static double lastSum[Metrics::MAX];
+	static uint64_t lastCount[Metrics::MAX], lastBuckets[Metrics::MAX][Metrics::BUCKETS];
+
+	//kept after the thread ends so the totals still add up
+	static ThreadSlots& localSlots() {
+		thread_local ThreadSlots* mine=nullptr;
+		if (!mine) {
+			mine=new ThreadSlots();
+			std::lock_guard<std::mutex> lock(registryMtx);
+			threadSlots.push_back(mine);
+		}
+		return *mine;
+	}
+
+	static Metrics::Id registerMetric(const std::string& name, const std::string& help, Metrics::Kind kind) {
+		std::lock_guard<std::mutex> lock(registryMtx);
+		for (int i=0; i<(int)registered.size(); i++) {
+			if (registered[i].name==name) return i;
+		}
+		if (registered.size()>=Metrics::MAX) return -1;
+
+		Metrics::Value v;
+		v.name=name;
+		v.help=help;
+		v.kind=kind;
+		registered.push_back(v);
+		return registered.size()-1;
+	}
+
+	static inline void bump(std::atomic<double>& a, double v) {
+		a.store(a.load(std::memory_order_relaxed)+v, std::memory_order_relaxed);
+	}
+
+	static inline void bump(std::atomic<uint64_t>& a) {
+		a.store(a.load(std::memory_order_relaxed)+1, std::memory_order_relaxed);
+	}
+
+	double Metrics::Value::quantile(double q) const {
+		if (!this->frameCount) return 0;
+		uint64_t want=(uint64_t)ceil(q*this->frameCount), seen=0;
+		for (int b=0; b<BUCKETS; b++) {
+			seen+=this->frameBuckets[b];
+			if (seen>=want) return b==BUCKETS-1?INFINITY:ldexp(1, b);
+		}
+		return INFINITY;
+	}
+
+	Metrics::Id Metrics::counter(const std::string& name, const std::string& help) {
+		return registerMetric(name, help, Counter);
+	}
+
+	Metrics::Id Metrics::gauge(const std::string& name, const std::string& help) {
+		return registerMetric(name, help, Gauge);
+	}
+
+	Metrics::Id Metrics::histogram(const std::string& name, const std::string& help) {
+		return registerMetric(name, help, Histogram);
+	}
+
+	void Metrics::add(Id id, double v) {
+		if (id<0) return;
+		bump(localSlots().slots[id].sum, v);
+	}
+
+	void Metrics::set(Id id, double v) {
+		if (id<0) return;
+		gauges[id].store(v, std::memory_order_relaxed);
+	}
+
+	void Metrics::observe(Id id, double v) {
+		if (id<0) return;
+		MetricSlot& s=localSlots().slots[id];
+		bump(s.sum, v);
+		bump(s.count);
+
+		//v at most 2^e, and above 2^(e-1) from 1 up. powers of 2 land on their own edge
+		int e=0;
+		if (v>1&&frexp(v, &e)==0.5) e--;
+		bump(s.buckets[e<BUCKETS?e:BUCKETS-1]);
+	}
+
+	void Metrics::endFrame() {
+		std::lock_guard<std::mutex> lock(registryMtx);
+		for (int i=0; i<(int)registered.size(); i++) {
+			Value& v=registered[i];
+			if (v.kind==Gauge) {
+				v.frame=v.total=gauges[i].load(std::memory_order_relaxed);
+				continue;
+			}
+
+			double sum=0;
+			uint64_t count=0, buckets[BUCKETS]={};
+			for (ThreadSlots* t:threadSlots) {
+				MetricSlot& s=t->slots[i];
+				sum+=s.sum.load(std::memory_order_relaxed);
+				count+=s.count.load(std::memory_order_relaxed);
+				for (int b=0; b<BUCKETS; b++) buckets[b]+=s.buckets[b].load(std::memory_order_relaxed);
+			}
+
+			v.frame=sum-lastSum[i];
+			v.total=lastSum[i]=sum;
+			v.frameCount=count-lastCount[i];
+			v.totalCount=lastCount[i]=count;
+			for (int b=0; b<BUCKETS; b++) {
+				v.frameBuckets[b]=buckets[b]-lastBuckets[i][b];
+				v.totalBuckets[b]=lastBuckets[i][b]=buckets[b];
+			}
+		}
+	}
+
+	const std::vector<Metrics::Value>& Metrics::values() {
+		return registered;
+	}
+
+	//short enough for an overlay row
+	static std::string formatValue(const Metrics::Value& v) {
+		char buf[64];
+		if (v.kind==Metrics::Histogram) {
+			double mean=v.frameCount?v.frame/v.frameCount:0;
+			snprintf(buf, sizeof(buf), "n=%llu avg=%.4g p95<=%.4g", (unsigned long long)v.frameCount, mean, v.quantile(0.95));
+		}
+		else snprintf(buf, sizeof(buf), "%.6g", v.frame);
+		return buf;
+	}
+
+	void Metrics::drawOverlay(Raster& rst, int x, int y) {
+		if (registered.empty()) return;
+
+		//size box to the longest row
+		int nameW=0, valW=0;
+		std::vector<std::string> vals;
+		for (const Value& v:registered) {
+			vals.push_back(formatValue(v));
+			if ((int)v.name.size()>nameW) nameW=v.name.size();
+			if ((int)vals.back().size()>valW) valW=vals.back().size();
+		}
+
+		rst.setChar(' ');
+		rst.setColor(Raster::WHITE);
+		rst.fillRect(x, y, nameW+valW+3, registered.size()+2);
+		for (int i=0; i<(int)registered.size(); i++) {
+			rst.setColor(Raster::GREY);
+			rst.drawString(x+1, y+1+i, registered[i].name);
+			rst.setColor(Raster::WHITE);
+			rst.drawString(x+nameW+2, y+1+i, vals[i]);
+		}
+	}
+
+	//prometheus names are [a-zA-Z0-9_:], counters end in _total
+	static std::string promName(std::string name, Metrics::Kind kind) {
+		for (char& c:name) if (!isalnum((unsigned char)c)&&c!=':') c='_';
+		static const std::string TOTAL="_total";
+		bool hasTotal=name.size()>=TOTAL.size()&&name.compare(name.size()-TOTAL.size(), TOTAL.size(), TOTAL)==0;
+		if (kind==Metrics::Counter&&!hasTotal) name+=TOTAL;
+		return name;
+	}
+
+	bool Metrics::writePrometheus(std::string path) {
+		FILE* file=fopen(path.c_str(), "w");
+		if (!file) return false;
+
+		static const char* TYPES[3]={"counter", "gauge", "histogram"};
+		for (const Value& v:registered) {
+			std::string n=promName(v.name, v.kind);
+			if (!v.help.empty()) fprintf(file, "# HELP %s %s\n", n.c_str(), v.help.c_str());
+			fprintf(file, "# TYPE %s %s\n", n.c_str(), TYPES[v.kind]);
+			if (v.kind!=Histogram) {
+				fprintf(file, "%s %.9g\n", n.c_str(), v.total);
+				continue;
+			}
+
+			//buckets are cumulative there
+			uint64_t seen=0;
+			for (int b=0; b<BUCKETS-1; b++) {
+				seen+=v.totalBuckets[b];
+				fprintf(file, "%s_bucket{le=\"%.9g\"} %llu\n", n.c_str(), ldexp(1, b), (unsigned long long)seen);
+			}
+			fprintf(file, "%s_bucket{le=\"+Inf\"} %llu\n", n.c_str(), (unsigned long long)v.totalCount);
+			fprintf(file, "%s_sum %.9g\n", n.c_str(), v.total);
+			fprintf(file, "%s_count %llu\n", n.c_str(), (unsigned long long)v.totalCount);
+		}
+
+		fclose(file);
+		return true;
+	}
+
+	bool Metrics::writeCSV(std::string path) {
+		FILE* file=fopen(path.c_str(), "w");
+		if (!file) return false;
+
+		static const char* TYPES[3]={"counter", "gauge", "histogram"};
+		fprintf(file, "name,kind,frame,total,frameCount,totalCount,p50,p95\n");
+		for (const Value& v:registered) {
+			fprintf(file, "%s,%s,%.9g,%.9g,%llu,%llu,%.9g,%.9g\n", v.name.c_str(), TYPES[v.kind], v.frame, v.total,
+				(unsigned long long)v.frameCount, (unsigned long long)v.totalCount, v.quantile(0.5), v.quantile(0.95));
+		}
+
+		fclose(file);
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace displib {
+#pragma once
+	class Raster;
+
+	//named counters, gauges and histograms for what a sim does each frame.
+	//each thread writes its own slots without locking, endFrame gathers them once a frame.
+	class Metrics {
+		public:
+		enum Kind {
+			Counter,
+			Gauge,
+			Histogram
+		};
+
+		//at most this many metrics, so slots never move while other threads write them.
+		static const int MAX=128;
+
+		//histogram bucket b holds values up to and including 2^b, the last one everything else.
+		static const int BUCKETS=24;
+
+		//handle from counter/gauge/histogram, look it up once and keep it.
+		typedef int Id;
+
+		//one metric as of the last endFrame.
+		struct Value {
+			std::string name, help;
+			Kind kind;
+
+			//counters and histograms: summed this frame and since the start.
+			//gauges: the last value set, in both.
+			double frame=0, total=0;
+
+			//histograms: observations, this frame and since the start.
+			uint64_t frameCount=0, totalCount=0;
+			uint64_t frameBuckets[BUCKETS]={}, totalBuckets[BUCKETS]={};
+
+			//upper bucket edge at or under which this fraction of this frame's observations fall.
+			double quantile(double q) const;
+		};
+
+		//registering the same name twice gives the same id, -1 once full.
+		static Id counter(const std::string& name, const std::string& help="");
+		static Id gauge(const std::string& name, const std::string& help="");
+		static Id histogram(const std::string& name, const std::string& help="");
+
+		static void add(Id id, double v=1);
+
+		static void set(Id id, double v);
+
+		static void observe(Id id, double v);
+
+		//sums every thread's slots into values, the engine calls this after each draw.
+		static void endFrame();
+
+		static const std::vector<Value>& values();
+
+		//name and this frame's value, one per row, boxed so it reads over anything.
+		static void drawOverlay(Raster& rst, int x, int y);
+
+		//prometheus text format, totals since the start. counters get the _total suffix.
+		static bool writePrometheus(std::string path);
+
+		//one row per metric, this frame and totals.
+		static bool writeCSV(std::string path);
+	};
+}
\ No newline at end of file
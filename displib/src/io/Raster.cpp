@@ -1,15 +1,27 @@
 #include "Raster.h"
+#include "../geom/Polyline.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <emmintrin.h>
 
 namespace displib {
 	Raster::Raster() : Raster::Raster(10, 10) {}
 
-	Raster::Raster(int w, int h) {
+	Raster::Raster(int w, int h) : Raster::Raster(w, h, false) {}
+
+	Raster::Raster(int w, int h, bool halfBlocks_) {
 		this->width=w;
 		this->height=h;
+		this->halfBlocks=halfBlocks_;
 
 		//screen bfr
 		this->charBuffer=new CHAR_INFO[this->width*this->height];
 
+		//what actually gets shown
+		if (this->halfBlocks) this->packedBuffer=new CHAR_INFO[this->width*(this->height/2)];
+
 		//set default char to space
 		this->setChar(32);
 
@@ -17,6 +29,42 @@ namespace displib {
 		this->setColor(WHITE);
 	}
 
+	Raster::Raster(const Raster& rst) {
+		this->width=rst.width;
+		this->height=rst.height;
+		this->currChar=rst.currChar;
+		this->layers=rst.layers;
+		this->charBuffer=new CHAR_INFO[this->width*this->height];
+		memcpy(this->charBuffer, rst.charBuffer, sizeof(CHAR_INFO)*this->width*this->height);
+		this->halfBlocks=rst.halfBlocks;
+		if (this->halfBlocks) this->packedBuffer=new CHAR_INFO[this->width*(this->height/2)];
+	}
+
+	Raster& Raster::operator=(const Raster& rst) {
+		if (this!=&rst) {
+			delete[] this->charBuffer;
+			delete[] this->packedBuffer;
+			//scratch may be the wrong size now, next bake makes a new one
+			delete this->layerScratch;
+			this->layerScratch=nullptr;
+			this->width=rst.width;
+			this->height=rst.height;
+			this->currChar=rst.currChar;
+			this->layers=rst.layers;
+			this->charBuffer=new CHAR_INFO[this->width*this->height];
+			memcpy(this->charBuffer, rst.charBuffer, sizeof(CHAR_INFO)*this->width*this->height);
+			this->halfBlocks=rst.halfBlocks;
+			this->packedBuffer=this->halfBlocks?new CHAR_INFO[this->width*(this->height/2)]:nullptr;
+		}
+		return *this;
+	}
+
+	Raster::~Raster() {
+		delete[] this->charBuffer;
+		delete[] this->packedBuffer;
+		delete this->layerScratch;
+	}
+
 	void Raster::setChar(short c) { this->currChar.Char.UnicodeChar=c; }
 
 	void Raster::setColor(short c) { this->currChar.Attributes=c; }
@@ -86,6 +134,40 @@ namespace displib {
 	void Raster::drawLine(float x1, float y1, float x2, float y2) { this->_drawLine(round(x1), round(y1), round(x2), round(y2)); }
 	void Raster::drawLine(float2 v1, float2 v2) { this->drawLine(v1.x, v1.y, v2.x, v2.y); }
 
+	void Raster::_drawSegment(int x1, int y1, int x2, int y2, bool skipStart, bool skipEnd) {
+		int dx=abs(x2-x1), sx=x1<x2?1:-1;
+		int dy=-abs(y2-y1), sy=y1<y2?1:-1;
+		int err=dx+dy;
+		int x=x1, y=y1;
+		if (!skipStart) this->_putPixel(x, y);
+		while (x!=x2||y!=y2) {
+			int e2=2*err;
+			if (e2>=dy) { err+=dy; x+=sx; }
+			if (e2<=dx) { err+=dx; y+=sy; }
+			if (skipEnd&&x==x2&&y==y2) break;
+			this->_putPixel(x, y);
+		}
+	}
+
+	void Raster::drawPolyline(const float2* pts, int n, bool closed) {
+		if (n<=0) return;
+
+		int fx=round(pts[0].x), fy=round(pts[0].y);
+		int px=fx, py=fy;
+		this->_putPixel(px, py);
+		for (int i=1; i<n; i++) {
+			int x=round(pts[i].x), y=round(pts[i].y);
+			//points closer than a cell add nothing
+			if (x==px&&y==py) continue;
+			this->_drawSegment(px, py, x, y, true, false);
+			px=x, py=y;
+		}
+		//first point is already down
+		if (closed&&(px!=fx||py!=fy)) this->_drawSegment(px, py, fx, fy, true, true);
+	}
+	void Raster::drawPolyline(const std::vector<float2>& pts, bool closed) { this->drawPolyline(pts.data(), pts.size(), closed); }
+	void Raster::drawPolyline(const Polyline& line) { this->drawPolyline(line.data(), line.size(), false); }
+
 	void Raster::_drawTriangle(int x1, int y1, int x2, int y2, int x3, int y3) {
 		this->drawLine(x1, y1, x2, y2);
 		this->drawLine(x2, y2, x3, y3);
@@ -284,6 +366,99 @@ namespace displib {
 	void Raster::fillRect(float x, float y, float w, float h) { this->_fillRect(round(x), round(y), round(w), round(h)); }
 	void Raster::fillRect(float2 v, float w, float h) { this->fillRect(v.x, v.y, w, h); }
 
+	void Raster::_addEdge(float2 a, float2 b) {
+		//flat edges never cross a scanline
+		if (a.y==b.y) return;
+
+		int dir=1;
+		if (a.y>b.y) {
+			std::swap(a, b);
+			dir=-1;
+		}
+		this->edges.push_back({a.x, a.y, b.y, (b.x-a.x)/(b.y-a.y), dir});
+	}
+
+	void Raster::_fillEdges(int rule) {
+		if (this->edges.empty()) return;
+
+		//edges join the active table in order of their top
+		std::sort(this->edges.begin(), this->edges.end(), [](const Edge& a, const Edge& b) { return a.y0<b.y0; });
+		float bottom=this->edges[0].y1;
+		for (const Edge& e:this->edges) if (e.y1>bottom) bottom=e.y1;
+
+		//cell centers sit on whole numbers, an edge covers rows y0<=y<y1
+		int yStart=ceilf(this->edges[0].y0);
+		if (yStart<0) yStart=0;
+		int yEnd=ceilf(bottom);
+		if (yEnd>this->height) yEnd=this->height;
+
+		size_t next=0;
+		this->activeEdges.clear();
+		for (int y=yStart; y<yEnd; y++) {
+			//add edges starting by this row, x moved to the row
+			while (next<this->edges.size()&&this->edges[next].y0<=y) {
+				Edge e=this->edges[next++];
+				if (e.y1<=y) continue;
+				e.x+=(y-e.y0)*e.dxdy;
+				this->activeEdges.push_back(e);
+			}
+
+			//drop finished edges
+			int n=0;
+			for (const Edge& e:this->activeEdges) if (e.y1>y) this->activeEdges[n++]=e;
+			this->activeEdges.resize(n);
+
+			//mostly still in order from last row, insertion sort is near linear
+			for (int i=1; i<n; i++) {
+				Edge e=this->activeEdges[i];
+				int j=i-1;
+				while (j>=0&&this->activeEdges[j].x>e.x) {
+					this->activeEdges[j+1]=this->activeEdges[j];
+					j--;
+				}
+				this->activeEdges[j+1]=e;
+			}
+
+			//spans between crossings that are inside
+			CHAR_INFO* row=this->charBuffer+y*this->width;
+			int winding=0;
+			for (int i=0; i+1<n; i++) {
+				winding+=rule==NONZERO?this->activeEdges[i].dir:1;
+				bool inside=rule==NONZERO?winding!=0:(winding&1);
+				if (!inside) continue;
+
+				int xa=ceilf(this->activeEdges[i].x);
+				int xb=ceilf(this->activeEdges[i+1].x);
+				if (xa<0) xa=0;
+				if (xb>this->width) xb=this->width;
+				for (int x=xa; x<xb; x++) row[x]=this->currChar;
+			}
+
+			//step to the next row
+			for (Edge& e:this->activeEdges) e.x+=e.dxdy;
+		}
+		this->edges.clear();
+	}
+
+	void Raster::fillPolygon(const float2* pts, int n, int rule) {
+		for (int i=0; i<n; i++) this->_addEdge(pts[i], pts[(i+1)%n]);
+		this->_fillEdges(rule);
+	}
+	void Raster::fillPolygon(const std::vector<float2>& pts, int rule) { this->fillPolygon(pts.data(), pts.size(), rule); }
+
+	void Raster::fillPolygon(const std::vector<std::vector<float2>>& contours, int rule) {
+		for (const std::vector<float2>& c:contours) {
+			int n=c.size();
+			for (int i=0; i<n; i++) this->_addEdge(c[i], c[(i+1)%n]);
+		}
+		this->_fillEdges(rule);
+	}
+
+	void Raster::fillSegments(const std::vector<std::pair<float2, float2>>& segs, int rule) {
+		for (const auto& s:segs) this->_addEdge(s.first, s.second);
+		this->_fillEdges(rule);
+	}
+
 	//draws a string starting from the left at the specified point, with the col, @ the char size
 	void Raster::_drawString(int x_, int y, std::string str) {
 		int x=x_;
@@ -298,8 +473,93 @@ namespace displib {
 	void Raster::drawString(float x, float y, std::string str) { this->_drawString(round(x), round(y), str); }
 	void Raster::drawString(float2 v, std::string str) { this->drawString(v.x, v.y, str); }
 
+	void Raster::_blit(const Sprite& spr, int x, int y) {
+		//fully offscreen
+		if (x>=this->width||y>=this->height||x+spr.width<=0||y+spr.height<=0) return;
+
+		//clip rows once
+		int sj=y<0?-y:0;
+		int ej=y+spr.height>this->height?this->height-y:spr.height;
+		for (int j=sj; j<ej; j++) {
+			CHAR_INFO* row=this->charBuffer+(y+j)*this->width;
+			for (int r=spr.rowStarts[j]; r<spr.rowStarts[j+1]; r++) {
+				const Sprite::Run& run=spr.runs[r];
+				//clip run to the raster
+				int sx=x+run.x;
+				int ex=sx+run.length;
+				int skip=sx<0?-sx:0;
+				if (ex>this->width) ex=this->width;
+				if (sx+skip>=ex) continue;
+
+				memcpy(row+sx+skip, spr.cells.data()+run.offset+skip, sizeof(CHAR_INFO)*(ex-sx-skip));
+			}
+		}
+	}
+	void Raster::blit(const Sprite& spr, float x, float y) { this->_blit(spr, round(x), round(y)); }
+	void Raster::blit(const Sprite& spr, float2 v) { this->blit(spr, v.x, v.y); }
+
+	void Raster::invalidateLayer(int id) {
+		if (id>=0&&id<(int)this->layers.size()) this->layers[id].clean=false;
+	}
+
+	void Raster::drawLayer(int id, std::function<void(Raster&)> drawFunc) {
+		if (id>=(int)this->layers.size()) this->layers.resize(id+1);
+		Layer& layer=this->layers[id];
+		//only rasterize when changed
+		if (!layer.clean) {
+			if (!this->layerScratch) this->layerScratch=new Raster(this->width, this->height);
+			Sprite::bake(layer.sprite, *this->layerScratch, drawFunc);
+			layer.clean=true;
+		}
+		this->_blit(layer.sprite, 0, 0);
+	}
+
 	//returns the 2d raster buffer
 	CHAR_INFO* Raster::getBuffer() {
 		return this->charBuffer;
 	}
+
+	CHAR_INFO* Raster::getOutput() {
+		if (!this->halfBlocks) return this->charBuffer;
+
+		//the vector pass reads a char as one int: low word char, high word attributes
+		static_assert(sizeof(CHAR_INFO)==4, "CHAR_INFO must be 4 bytes");
+
+		const __m128i charMask=_mm_set1_epi32(0xFFFF);
+		const __m128i space=_mm_set1_epi32(' ');
+		const __m128i nibble=_mm_set1_epi32(0xF);
+		const __m128i upperHalf=_mm_set1_epi32(0x2580);
+		auto pixelColor=[&](const __m128i& c) {
+			__m128i isSpace=_mm_cmpeq_epi32(_mm_and_si128(c, charMask), space);
+			__m128i fg=_mm_and_si128(_mm_srli_epi32(c, 16), nibble);
+			__m128i bg=_mm_and_si128(_mm_srli_epi32(c, 20), nibble);
+			return _mm_or_si128(_mm_andnot_si128(isSpace, fg), _mm_and_si128(isSpace, bg));
+		};
+
+		for (int j=0; j<this->height/2; j++) {
+			const CHAR_INFO* top=this->charBuffer+2*j*this->width;
+			const CHAR_INFO* bottom=top+this->width;
+			CHAR_INFO* out=this->packedBuffer+j*this->width;
+
+			//four chars at a time, top pixel is foreground, bottom is background
+			int i=0;
+			for (; i+4<=this->width; i+=4) {
+				__m128i t=pixelColor(_mm_loadu_si128((const __m128i*)(top+i)));
+				__m128i b=pixelColor(_mm_loadu_si128((const __m128i*)(bottom+i)));
+				__m128i attr=_mm_or_si128(t, _mm_slli_epi32(b, 4));
+				_mm_storeu_si128((__m128i*)(out+i), _mm_or_si128(upperHalf, _mm_slli_epi32(attr, 16)));
+			}
+
+			//leftovers
+			for (; i<this->width; i++) {
+				const CHAR_INFO& t=top[i];
+				const CHAR_INFO& b=bottom[i];
+				WORD tc=t.Char.UnicodeChar==' '?(t.Attributes>>4)&0xF:t.Attributes&0xF;
+				WORD bc=b.Char.UnicodeChar==' '?(b.Attributes>>4)&0xF:b.Attributes&0xF;
+				out[i].Char.UnicodeChar=0x2580;
+				out[i].Attributes=tc|(bc<<4);
+			}
+		}
+		return this->packedBuffer;
+	}
 }
\ No newline at end of file
@@ -1,21 +1,53 @@
-#define _WIN32_WINNT 0x0500
-
-#include <windows.h>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "../maths/vector/float2.h"
+#include "Console.h"
+#include "Sprite.h"
 
 namespace displib {
 #pragma once
+	class Polyline;
+
 	class Raster {
 		private:
 		CHAR_INFO* charBuffer;
 		CHAR_INFO currChar;
 
+		//half block mode packs two pixels into every console char.
+		bool halfBlocks=false;
+		CHAR_INFO* packedBuffer=nullptr;
+
+		//cached static art, only redrawn once invalidated.
+		struct Layer {
+			Sprite sprite;
+			bool clean=false;
+		};
+		std::vector<Layer> layers;
+
+		//layers are baked through this, made on the first bake and kept so rebakes dont allocate.
+		Raster* layerScratch=nullptr;
+
+		//one polygon edge, top end first.
+		struct Edge {
+			float x, y0, y1, dxdy;
+			int dir;
+		};
+		std::vector<Edge> edges, activeEdges;
+
+		void _addEdge(float2 a, float2 b);
+
+		//scanline fills whatever is in edges, then empties it.
+		void _fillEdges(int rule);
+
 		void _putPixel(int x, int y);
 
 		void _drawLine(int x1, int y1, int x2, int y2);
 
+		//walks from start to end in order, so the start can be left to the previous segment.
+		void _drawSegment(int x1, int y1, int x2, int y2, bool skipStart, bool skipEnd);
+
 		void _drawTriangle(int x1, int y1, int x2, int y2, int x3, int y3);
 
 		void _fillTriangle(int x1, int y1, int x2, int y2, int x3, int y3);
@@ -30,6 +62,8 @@ namespace displib {
 
 		void _drawString(int x_, int y, std::string str);
 
+		void _blit(const Sprite& spr, int x, int y);
+
 		public:
 		//list of console colors, thanks javidx9
 		enum COLORS {
@@ -51,6 +85,13 @@ namespace displib {
 			WHITE=0x000F
 		};
 
+		//which cells a polygon covers. even odd fills where an odd number of edges are crossed to the left,
+		//nonzero where edges going down and up dont cancel, so overlaps and loops stay filled.
+		enum FILL_RULES {
+			EVEN_ODD,
+			NONZERO
+		};
+
 		int width, height;
 
 		Raster();//dont use
@@ -58,6 +99,15 @@ namespace displib {
 		//construct new buffer for raster
 		Raster(int w, int h);
 
+		//construct new buffer for raster, in half block mode h is the pixel height, twice the console height.
+		Raster(int w, int h, bool halfBlocks_);
+
+		Raster(const Raster& rst);
+
+		Raster& operator=(const Raster& rst);
+
+		~Raster();
+
 		//set current console char.
 		void setChar(short c);
 
@@ -70,6 +120,21 @@ namespace displib {
 		//renders line of current char from [x1, y1] to [x2, y2]
 		void drawLine(float x1, float y1, float x2, float y2), drawLine(float2 v1, float2 v2);
 
+		//renders connected lines through n points, every shared point plotted once.
+		void drawPolyline(const float2* pts, int n, bool closed=false), drawPolyline(const std::vector<float2>& pts, bool closed=false);
+
+		//renders a ring polyline oldest to newest.
+		void drawPolyline(const Polyline& line);
+
+		//fills every cell whose coordinate is inside the polygon, closing it back to the first point.
+		void fillPolygon(const float2* pts, int n, int rule=EVEN_ODD), fillPolygon(const std::vector<float2>& pts, int rule=EVEN_ODD);
+
+		//fills several contours as one shape, so holes and overlaps follow the rule.
+		void fillPolygon(const std::vector<std::vector<float2>>& contours, int rule=EVEN_ODD);
+
+		//fills the shape bounded by loose segments, in any order, like marching squares gives.
+		void fillSegments(const std::vector<std::pair<float2, float2>>& segs, int rule=EVEN_ODD);
+
 		//renders triangle using specified coordinates.
 		void drawTriangle(float x1, float y1, float x2, float y2, float x3, float y3), drawTriangle(float2 v1, float2 v2, float2 v3);
 
@@ -91,7 +156,20 @@ namespace displib {
 		//renders string from left to right at specified coordinates.
 		void drawString(float x, float y, std::string str), drawString(float2 v, std::string str);
 
+		//copies sprite with its top left at specified coordinates, skipping transparent chars.
+		void blit(const Sprite& spr, float x, float y), blit(const Sprite& spr, float2 v);
+
+		//marks layer to be redrawn the next time it is drawn.
+		void invalidateLayer(int id);
+
+		//redraws layer with drawFunc only if invalidated, then copies it over the raster. new ids start invalidated.
+		void drawLayer(int id, std::function<void(Raster&)> drawFunc);
+
 		//returns the buffer data.
 		CHAR_INFO* getBuffer();
+
+		//returns the chars to show, in half block mode pixel pairs are packed into upper half blocks first.
+		//only colors survive packing: a space shows its background color, anything else its foreground.
+		CHAR_INFO* getOutput();
 	};
 }
\ No newline at end of file
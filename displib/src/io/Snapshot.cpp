@@ -0,0 +1,174 @@
+#include "Snapshot.h"
+
+namespace displib {
+	static const char MAGIC[4]={'D', 'S', 'N', 'P'};
+
+	static uint64_t padTo16(uint64_t n) {
+		return (n+15)&~(uint64_t)15;
+	}
+
+	static void copyTag(char* dst, const char* tag) {
+		//truncating would let two names share a chunk
+		if (strlen(tag)>4) {
+			printf("snapshot tag \"%s\" is longer than 4 chars. ending execution.", tag);
+			exit(1);
+		}
+		memset(dst, ' ', 4);
+		for (int i=0; i<4&&tag[i]; i++) dst[i]=tag[i];
+	}
+
+	SnapshotWriter::SnapshotWriter(std::string path, uint32_t version) {
+		memcpy(this->header.magic, MAGIC, 4);
+		this->header.format=FORMAT;
+		this->header.version=version;
+		this->header.chunkCount=0;
+		this->header.byteOrder=ORDER_MARK;
+		memset(this->header.reserved, 0, sizeof(this->header.reserved));
+
+		this->file=fopen(path.c_str(), "wb");
+		if (this->file) fwrite(&this->header, sizeof(SnapshotHeader), 1, this->file);
+	}
+
+	SnapshotWriter::~SnapshotWriter() {
+		this->close();
+	}
+
+	bool SnapshotWriter::ok() const {
+		return this->file&&!ferror(this->file);
+	}
+
+	void SnapshotWriter::put(const char* tag, const void* data, uint64_t bytes, uint32_t elemSize) {
+		if (!this->ok()) return;
+
+		SnapshotChunk chunk;
+		copyTag(chunk.tag, tag);
+		chunk.elemSize=elemSize;
+		chunk.bytes=bytes;
+		fwrite(&chunk, sizeof(SnapshotChunk), 1, this->file);
+		if (bytes) fwrite(data, 1, bytes, this->file);
+
+		//keep the next chunk aligned
+		static const char zeros[16]={};
+		fwrite(zeros, 1, padTo16(bytes)-bytes, this->file);
+
+		this->header.chunkCount++;
+	}
+
+	bool SnapshotWriter::close() {
+		if (!this->file) return false;
+
+		//count is only known now
+		fseek(this->file, 0, SEEK_SET);
+		fwrite(&this->header, sizeof(SnapshotHeader), 1, this->file);
+		bool good=!ferror(this->file);
+		good&=fclose(this->file)==0;
+		this->file=nullptr;
+		return good;
+	}
+
+	SnapshotReader::SnapshotReader(std::string path) {
+		this->open(path);
+	}
+
+	SnapshotReader::~SnapshotReader() {
+		this->release();
+	}
+
+	void SnapshotReader::release() {
+#ifdef _WIN32
+		if (this->base) UnmapViewOfFile(this->base);
+		if (this->mapHandle) CloseHandle(this->mapHandle);
+		if (this->fileHandle!=INVALID_HANDLE_VALUE) CloseHandle(this->fileHandle);
+		this->mapHandle=nullptr;
+		this->fileHandle=INVALID_HANDLE_VALUE;
+#else
+		this->buffer.clear();
+#endif
+		this->base=nullptr;
+		this->size=0;
+		this->entries.clear();
+	}
+
+	bool SnapshotReader::open(std::string path) {
+		this->release();
+
+#ifdef _WIN32
+		this->fileHandle=CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (this->fileHandle==INVALID_HANDLE_VALUE) return false;
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(this->fileHandle, &fileSize)||fileSize.QuadPart<(LONGLONG)sizeof(SnapshotHeader)) {
+			this->release();
+			return false;
+		}
+		this->mapHandle=CreateFileMappingA(this->fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!this->mapHandle) {
+			this->release();
+			return false;
+		}
+		this->base=(const char*)MapViewOfFile(this->mapHandle, FILE_MAP_READ, 0, 0, 0);
+		this->size=fileSize.QuadPart;
+#else
+		//no mapping here, one read of the whole file is still no parsing
+		FILE* file=fopen(path.c_str(), "rb");
+		if (!file) return false;
+		fseek(file, 0, SEEK_END);
+		long fileSize=ftell(file);
+		fseek(file, 0, SEEK_SET);
+		if (fileSize>0) {
+			this->buffer.resize(fileSize);
+			if (fread(this->buffer.data(), 1, fileSize, file)==(size_t)fileSize) {
+				this->base=this->buffer.data();
+				this->size=fileSize;
+			}
+		}
+		fclose(file);
+#endif
+		if (!this->base||this->size<sizeof(SnapshotHeader)) {
+			this->release();
+			return false;
+		}
+
+		//the mark reads back as 0x04030201 when the writer had the other byte order
+		const SnapshotHeader* header=(const SnapshotHeader*)this->base;
+		if (memcmp(header->magic, MAGIC, 4)!=0||header->byteOrder!=SnapshotWriter::ORDER_MARK||header->format!=SnapshotWriter::FORMAT) {
+			this->release();
+			return false;
+		}
+		this->version=header->version;
+
+		//walk the chunk headers, skipping over the data
+		uint64_t at=sizeof(SnapshotHeader);
+		for (uint32_t i=0; i<header->chunkCount; i++) {
+			if (at+sizeof(SnapshotChunk)>this->size) break;
+			const SnapshotChunk* chunk=(const SnapshotChunk*)(this->base+at);
+			at+=sizeof(SnapshotChunk);
+			if (chunk->bytes>this->size-at) break;
+			this->entries.push_back({*chunk, this->base+at});
+			at+=padTo16(chunk->bytes);
+		}
+
+		//truncated file
+		if (this->entries.size()!=header->chunkCount) {
+			this->release();
+			return false;
+		}
+		return true;
+	}
+
+	bool SnapshotReader::ok() const {
+		return this->base!=nullptr;
+	}
+
+	const void* SnapshotReader::find(const char* tag, uint64_t* bytes, uint32_t* elemSize) const {
+		char key[4];
+		copyTag(key, tag);
+		for (const Entry& e:this->entries) {
+			if (memcmp(e.chunk.tag, key, 4)!=0) continue;
+
+			if (bytes) *bytes=e.chunk.bytes;
+			if (elemSize) *elemSize=e.chunk.elemSize;
+			return e.data;
+		}
+		return nullptr;
+	}
+}
@@ -0,0 +1,146 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Console.h"
+
+namespace displib {
+#pragma once
+	//file layout, in the writing host's byte order, every header and data block starting 16 byte aligned:
+	//  header: "DSNP", format version, user version, chunk count, byte order mark, padding.
+	//  chunk:  4 char tag, element size, byte length, data padded to 16.
+	//the data is never swapped, a file from a host of the other byte order is refused on open.
+	struct SnapshotHeader {
+		char magic[4];
+		uint32_t format, version, chunkCount, byteOrder;
+		uint32_t reserved[3];
+	};
+
+	struct SnapshotChunk {
+		char tag[4];
+		uint32_t elemSize;
+		uint64_t bytes;
+	};
+
+	//streams chunks of plain arrays straight to a file.
+	class SnapshotWriter {
+		private:
+		FILE* file=nullptr;
+		SnapshotHeader header;
+
+		public:
+		static const uint32_t FORMAT=2;
+		static const uint32_t ORDER_MARK=0x01020304;
+
+		//version is the caller's own, so a demo can refuse snapshots of an older layout.
+		SnapshotWriter(std::string path, uint32_t version=0);
+
+		~SnapshotWriter();
+
+		bool ok() const;
+
+		//tag is up to 4 chars, longer ends execution, elemSize is kept so a mismatched struct cant be restored.
+		void put(const char* tag, const void* data, uint64_t bytes, uint32_t elemSize=1);
+
+		template<typename T>
+		void put(const char* tag, const T* data, size_t count) {
+			put(tag, data, count*sizeof(T), sizeof(T));
+		}
+
+		template<typename T>
+		void put(const char* tag, const std::vector<T>& v) {
+			put(tag, v.data(), v.size());
+		}
+
+		template<typename T>
+		void putValue(const char* tag, const T& val) {
+			put(tag, &val, 1);
+		}
+
+		//patches the chunk count in, returns false if any write failed.
+		bool close();
+	};
+
+	//maps a snapshot file and indexes its chunks, the data is read in place, never parsed.
+	class SnapshotReader {
+		private:
+		struct Entry {
+			SnapshotChunk chunk;
+			const char* data;
+		};
+
+		const char* base=nullptr;
+		uint64_t size=0;
+#ifdef _WIN32
+		HANDLE fileHandle=INVALID_HANDLE_VALUE, mapHandle=nullptr;
+#else
+		std::vector<char> buffer;
+#endif
+		std::vector<Entry> entries;
+
+		void release();
+
+		public:
+		uint32_t version=0;
+
+		SnapshotReader() {}
+
+		SnapshotReader(std::string path);
+
+		~SnapshotReader();
+
+		SnapshotReader(const SnapshotReader&)=delete;
+		SnapshotReader& operator=(const SnapshotReader&)=delete;
+
+		//false if the file is missing, truncated, or not a snapshot of this format and byte order.
+		bool open(std::string path);
+
+		bool ok() const;
+
+		//raw chunk, nullptr if there is none with this tag.
+		const void* find(const char* tag, uint64_t* bytes=nullptr, uint32_t* elemSize=nullptr) const;
+
+		//chunk as an array of exactly count T, nullptr if missing or any other size.
+		template<typename T>
+		const T* view(const char* tag, size_t count) const {
+			uint64_t bytes;
+			uint32_t elemSize;
+			const void* p=find(tag, &bytes, &elemSize);
+			if (!p||elemSize!=sizeof(T)||bytes!=count*sizeof(T)) return nullptr;
+			return (const T*)p;
+		}
+
+		//element count of a chunk of T, -1 if missing or a different element size.
+		template<typename T>
+		long long count(const char* tag) const {
+			uint64_t bytes;
+			uint32_t elemSize;
+			if (!find(tag, &bytes, &elemSize)||elemSize!=sizeof(T)) return -1;
+			return bytes/sizeof(T);
+		}
+
+		template<typename T>
+		bool get(const char* tag, T* dst, size_t count) const {
+			const T* src=view<T>(tag, count);
+			if (!src) return false;
+			memcpy(dst, src, count*sizeof(T));
+			return true;
+		}
+
+		template<typename T>
+		bool get(const char* tag, std::vector<T>& dst) const {
+			long long n=count<T>(tag);
+			if (n<0) return false;
+			dst.resize(n);
+			return get(tag, dst.data(), n);
+		}
+
+		template<typename T>
+		bool getValue(const char* tag, T& val) const {
+			return get(tag, &val, 1);
+		}
+	};
+}
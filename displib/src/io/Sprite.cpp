@@ -0,0 +1,72 @@
+#include "Sprite.h"
+#include "Raster.h"
+
+namespace displib {
+	Sprite::Sprite() {
+		this->rowStarts.push_back(0);
+	}
+
+	Sprite::Sprite(int w, int h, const CHAR_INFO* data, CHAR_INFO transparent) {
+		this->encode(w, h, data, transparent);
+	}
+
+	void Sprite::encode(int w, int h, const CHAR_INFO* data, CHAR_INFO transparent) {
+		this->width=w;
+		this->height=h;
+		this->runs.clear();
+		this->rowStarts.clear();
+		this->cells.clear();
+
+		auto isOpaque=[&](const CHAR_INFO& c) {
+			return c.Char.UnicodeChar!=transparent.Char.UnicodeChar||c.Attributes!=transparent.Attributes;
+		};
+
+		for (int j=0; j<h; j++) {
+			this->rowStarts.push_back(this->runs.size());
+			const CHAR_INFO* row=data+j*w;
+			for (int i=0; i<w;) {
+				//skip see through chars
+				if (!isOpaque(row[i])) { i++; continue; }
+
+				//extend run as far as it goes
+				int s=i;
+				while (i<w&&isOpaque(row[i])) i++;
+				this->runs.push_back({(short)s, (short)(i-s), (int)this->cells.size()});
+				this->cells.insert(this->cells.end(), row+s, row+i);
+			}
+		}
+		this->rowStarts.push_back(this->runs.size());
+	}
+
+	Sprite Sprite::bake(int w, int h, std::function<void(Raster&)> drawFunc) {
+		Sprite spr;
+		Sprite::bake(spr, w, h, drawFunc);
+		return spr;
+	}
+
+	void Sprite::bake(Sprite& out, int w, int h, std::function<void(Raster&)> drawFunc) {
+		Raster rst(w, h);
+		Sprite::bake(out, rst, drawFunc);
+	}
+
+	void Sprite::bake(Sprite& out, Raster& rst, std::function<void(Raster&)> drawFunc) {
+		int w=rst.width, h=rst.height;
+
+		//char no draw call will produce
+		CHAR_INFO transparent;
+		transparent.Char.UnicodeChar=0;
+		transparent.Attributes=0xFFFF;
+
+		//clear scratch to transparent
+		rst.setChar(transparent.Char.UnicodeChar);
+		rst.setColor(transparent.Attributes);
+		rst.fillRect(0, 0, w, h);
+
+		//same state as a new raster
+		rst.setChar(32);
+		rst.setColor(Raster::WHITE);
+		drawFunc(rst);
+
+		out.encode(w, h, rst.getBuffer(), transparent);
+	}
+}
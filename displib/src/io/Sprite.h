@@ -0,0 +1,44 @@
+#include <functional>
+#include <vector>
+
+#include "Console.h"
+
+namespace displib {
+#pragma once
+	class Raster;
+
+	class Sprite {
+		public:
+		//horizontal strip of opaque chars in one row.
+		struct Run {
+			short x, length;
+			int offset;
+		};
+
+		int width=0, height=0;
+
+		//runs sorted by row, row j owns runs[rowStarts[j]] to runs[rowStarts[j+1]].
+		std::vector<Run> runs;
+		std::vector<int> rowStarts;
+
+		//opaque chars, packed run after run.
+		std::vector<CHAR_INFO> cells;
+
+		Sprite();
+
+		//run length encode w*h chars, leaving out any that match the transparent char.
+		Sprite(int w, int h, const CHAR_INFO* data, CHAR_INFO transparent);
+
+		//same as the constructor, but keeps this sprite's storage to refill.
+		void encode(int w, int h, const CHAR_INFO* data, CHAR_INFO transparent);
+
+		//draws into a scratch raster once, keeping only the chars that were drawn to.
+		static Sprite bake(int w, int h, std::function<void(Raster&)> drawFunc);
+
+		//bakes into out, reusing its storage when it is baked again.
+		static void bake(Sprite& out, int w, int h, std::function<void(Raster&)> drawFunc);
+
+		//bakes into out through a caller kept scratch raster, the sprite takes the scratch's size.
+		static void bake(Sprite& out, Raster& scratch, std::function<void(Raster&)> drawFunc);
+	};
+}
@@ -3,7 +3,7 @@
 Stopwatch::Stopwatch() {}
 
 std::chrono::steady_clock::time_point Stopwatch::getTime() {
-	return std::chrono::high_resolution_clock::now();
+	return std::chrono::steady_clock::now();
 }
 
 void Stopwatch::start() {
@@ -1,5 +1,7 @@
 #include <chrono>
 
+#pragma once
+
 class Stopwatch {
 	public:
 	std::chrono::steady_clock::time_point startTime, endTime;
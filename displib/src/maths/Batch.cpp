@@ -0,0 +1,115 @@
+#include "Batch.h"
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace displib {
+	//in BatchAVX2.cpp, only ever called once hasAVX2 says so
+	namespace avx2 {
+		void addScaled(float* out, const float* a, float s, int n);
+		void integrate(float* p, float* v, float* a, float dt, int n);
+	}
+
+	namespace sse2 {
+		void addScaled(float* out, const float* a, float s, int n) {
+			floatx8 s8(s);
+			int i=0;
+			for (; i+8<=n; i+=8) {
+				floatx8 o=floatx8::load(out+i)+floatx8::load(a+i)*s8;
+				o.store(out+i);
+			}
+			//masked tail
+			if (i<n) {
+				int r=n-i;
+				floatx8 o=floatx8::loadPartial(out+i, r)+floatx8::loadPartial(a+i, r)*s8;
+				o.storePartial(out+i, r);
+			}
+		}
+
+		void integrate(float* p, float* v, float* a, float dt, int n) {
+			floatx8 dt8(dt), zero;
+			int i=0;
+			for (; i+8<=n; i+=8) {
+				floatx8 v8=floatx8::load(v+i)+floatx8::load(a+i)*dt8;
+				floatx8 p8=floatx8::load(p+i)+v8*dt8;
+				v8.store(v+i);
+				p8.store(p+i);
+				zero.store(a+i);
+			}
+			//masked tail
+			if (i<n) {
+				int r=n-i;
+				floatx8 v8=floatx8::loadPartial(v+i, r)+floatx8::loadPartial(a+i, r)*dt8;
+				floatx8 p8=floatx8::loadPartial(p+i, r)+v8*dt8;
+				v8.storePartial(v+i, r);
+				p8.storePartial(p+i, r);
+				zero.storePartial(a+i, r);
+			}
+		}
+	}
+
+	static bool detectAVX2() {
+#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0]<7) return false;
+
+		//avx and os saving ymm regs
+		__cpuid(info, 1);
+		bool osxsave=(info[2]&(1<<27))!=0;
+		bool avx=(info[2]&(1<<28))!=0;
+		if (!osxsave||!avx) return false;
+		if ((_xgetbv(0)&6)!=6) return false;
+
+		__cpuidex(info, 7, 0);
+		return (info[1]&(1<<5))!=0;
+#else
+		return __builtin_cpu_supports("avx2");
+#endif
+	}
+
+	//chosen kernels, avx2 if the cpu has it
+	static void(*addScaledFunc)(float*, const float*, float, int)=Batch::hasAVX2()?avx2::addScaled:sse2::addScaled;
+	static void(*integrateFunc)(float*, float*, float*, float, int)=Batch::hasAVX2()?avx2::integrate:sse2::integrate;
+
+	Batch::Batch() {}
+
+	bool Batch::hasAVX2() {
+		static bool has=detectAVX2();
+		return has;
+	}
+
+	void Batch::setAVX2(bool on) {
+		on&=Batch::hasAVX2();
+		addScaledFunc=on?avx2::addScaled:sse2::addScaled;
+		integrateFunc=on?avx2::integrate:sse2::integrate;
+	}
+
+	bool Batch::usingAVX2() {
+		return integrateFunc==avx2::integrate;
+	}
+
+	void Batch::addScaled(float* out, const float* a, float s, int n) {
+		addScaledFunc(out, a, s, n);
+	}
+
+	void Batch::integrate(float* p, float* v, float* a, float dt, int n) {
+		integrateFunc(p, v, a, dt, n);
+	}
+
+	void Batch::integrate(float2Array& pos, float2Array& vel, float2Array& acc, float dt) {
+		//padding is always whole batches, no tails
+		int n=pos.paddedSize();
+		integrateFunc(pos.x(), vel.x(), acc.x(), dt, n);
+		integrateFunc(pos.y(), vel.y(), acc.y(), dt, n);
+	}
+
+	void Batch::integrate(float3Array& pos, float3Array& vel, float3Array& acc, float dt) {
+		//padding is always whole batches, no tails
+		int n=pos.paddedSize();
+		integrateFunc(pos.x(), vel.x(), acc.x(), dt, n);
+		integrateFunc(pos.y(), vel.y(), acc.y(), dt, n);
+		integrateFunc(pos.z(), vel.z(), acc.z(), dt, n);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#include "vector/SoA.h"
+
+namespace displib {
+#pragma once
+	//array kernels, 8 at a time.
+	//picks avx2 at runtime if the cpu has it, else sse2.
+	class Batch {
+		private:
+		Batch();
+
+		public:
+		//whether the cpu and os support avx2.
+		static bool hasAVX2();
+
+		//turn the avx2 path on or off, ignored if unsupported.
+		static void setAVX2(bool on);
+
+		//whether the avx2 path is in use.
+		static bool usingAVX2();
+
+		//out[i]+=a[i]*s, n floats.
+		static void addScaled(float* out, const float* a, float s, int n);
+
+		//euler explicit integ. v+=a*dt, p+=v*dt, then a is zeroed. n floats.
+		static void integrate(float* p, float* v, float* a, float dt, int n);
+		static void integrate(float2Array& pos, float2Array& vel, float2Array& acc, float dt);
+		static void integrate(float3Array& pos, float3Array& vel, float3Array& acc, float dt);
+	};
+}
@@ -0,0 +1,55 @@
+#include <immintrin.h>
+
+//msvc allows avx intrinsics anywhere, gcc and clang need them enabled per function
+#ifdef _MSC_VER
+#define AVX2_FUNC
+#else
+#define AVX2_FUNC __attribute__((target("avx2")))
+#endif
+
+namespace displib {
+	//same kernels as the sse2 ones in Batch.cpp, one ymm reg per 8 floats.
+	//no fma, so results match the sse2 path bit for bit.
+	namespace avx2 {
+		//lanes below n set
+		AVX2_FUNC static __m256i tailMask(int n) {
+			return _mm256_cmpgt_epi32(_mm256_set1_epi32(n), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+		}
+
+		AVX2_FUNC void addScaled(float* out, const float* a, float s, int n) {
+			__m256 s8=_mm256_set1_ps(s);
+			int i=0;
+			for (; i+8<=n; i+=8) {
+				__m256 o=_mm256_add_ps(_mm256_loadu_ps(out+i), _mm256_mul_ps(_mm256_loadu_ps(a+i), s8));
+				_mm256_storeu_ps(out+i, o);
+			}
+			//masked tail
+			if (i<n) {
+				__m256i m=tailMask(n-i);
+				__m256 o=_mm256_add_ps(_mm256_maskload_ps(out+i, m), _mm256_mul_ps(_mm256_maskload_ps(a+i, m), s8));
+				_mm256_maskstore_ps(out+i, m, o);
+			}
+		}
+
+		AVX2_FUNC void integrate(float* p, float* v, float* a, float dt, int n) {
+			__m256 dt8=_mm256_set1_ps(dt), zero=_mm256_setzero_ps();
+			int i=0;
+			for (; i+8<=n; i+=8) {
+				__m256 v8=_mm256_add_ps(_mm256_loadu_ps(v+i), _mm256_mul_ps(_mm256_loadu_ps(a+i), dt8));
+				__m256 p8=_mm256_add_ps(_mm256_loadu_ps(p+i), _mm256_mul_ps(v8, dt8));
+				_mm256_storeu_ps(v+i, v8);
+				_mm256_storeu_ps(p+i, p8);
+				_mm256_storeu_ps(a+i, zero);
+			}
+			//masked tail
+			if (i<n) {
+				__m256i m=tailMask(n-i);
+				__m256 v8=_mm256_add_ps(_mm256_maskload_ps(v+i, m), _mm256_mul_ps(_mm256_maskload_ps(a+i, m), dt8));
+				__m256 p8=_mm256_add_ps(_mm256_maskload_ps(p+i, m), _mm256_mul_ps(v8, dt8));
+				_mm256_maskstore_ps(v+i, m, v8);
+				_mm256_maskstore_ps(p+i, m, p8);
+				_mm256_maskstore_ps(a+i, m, zero);
+			}
+		}
+	}
+}
\ No newline at end of file
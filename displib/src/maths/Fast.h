@@ -0,0 +1,126 @@
+#include "Maths.h"
+#include "vector/floatx8.h"
+
+namespace displib {
+#pragma once
+	//polynomial stand ins for libm, scalar and 8 wide.
+	//max errors below are measured by displibBench over |x|<1000.
+	class Maths::fast {
+		private:
+		fast();
+
+		//pi/2 split in three so x-q*pi/2 stays exact for big q.
+		static constexpr float TWO_OVER_PI=0.636619772f;
+		static constexpr float PIO2_A=1.5703125f;
+		static constexpr float PIO2_B=4.83751297e-4f;
+		static constexpr float PIO2_C=7.54978995e-8f;
+
+		//sin and cos on [-pi/4, pi/4].
+		static float sinPoly(float r) {
+			float r2=r*r;
+			return r+r*r2*(-1.6666654611e-1f+r2*(8.3321608736e-3f+r2*-1.9515295891e-4f));
+		}
+		static float cosPoly(float r) {
+			float r2=r*r;
+			return 1-0.5f*r2+r2*r2*(4.166664568298827e-2f+r2*(-1.388731625493765e-3f+r2*2.443315711809948e-5f));
+		}
+		static floatx8 sinPoly(const floatx8& r) {
+			floatx8 r2=r*r;
+			return r+r*r2*(floatx8(-1.6666654611e-1f)+r2*(floatx8(8.3321608736e-3f)+r2*floatx8(-1.9515295891e-4f)));
+		}
+		static floatx8 cosPoly(const floatx8& r) {
+			floatx8 r2=r*r;
+			return floatx8(1)-floatx8(0.5f)*r2+r2*r2*(floatx8(4.166664568298827e-2f)+r2*(floatx8(-1.388731625493765e-3f)+r2*floatx8(2.443315711809948e-5f)));
+		}
+
+		//atan on [0, 1].
+		static float atanPoly(float a) {
+			float s=a*a;
+			return a*(0.99997726f+s*(-0.33262347f+s*(0.19354346f+s*(-0.11643287f+s*(0.05265332f+s*-0.01172120f)))));
+		}
+		static floatx8 atanPoly(const floatx8& a) {
+			floatx8 s=a*a;
+			return a*(floatx8(0.99997726f)+s*(floatx8(-0.33262347f)+s*(floatx8(0.19354346f)+s*(floatx8(-0.11643287f)+s*(floatx8(0.05265332f)+s*floatx8(-0.01172120f))))));
+		}
+
+		//flips sign of v where bit 1 of q is set.
+		static __m128 flipBy(__m128 v, __m128i q) {
+			return _mm_xor_ps(v, _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(q, _mm_set1_epi32(2)), 30)));
+		}
+
+		//all bits set where bit 0 of q is set.
+		static __m128 oddMask(__m128i q) {
+			__m128i one=_mm_set1_epi32(1);
+			return _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(q, one), one));
+		}
+
+		public:
+		//sin and cos at once, abs error under 2e-7.
+		static void sincos(float x, float& s, float& c) {
+			float fq=x*TWO_OVER_PI;
+			int q=(int)(fq<0?fq-0.5f:fq+0.5f);
+			float r=x-q*PIO2_A-q*PIO2_B-q*PIO2_C;
+			float ps=sinPoly(r), pc=cosPoly(r);
+			s=q&1?pc:ps;
+			c=q&1?ps:pc;
+			if (q&2) s=-s;
+			if ((q+1)&2) c=-c;
+		}
+
+		static void sincos(const floatx8& x, floatx8& s, floatx8& c) {
+			__m128i q[2]={_mm_cvtps_epi32(_mm_mul_ps(x.lo, _mm_set1_ps(TWO_OVER_PI))), _mm_cvtps_epi32(_mm_mul_ps(x.hi, _mm_set1_ps(TWO_OVER_PI)))};
+			floatx8 fq(_mm_cvtepi32_ps(q[0]), _mm_cvtepi32_ps(q[1]));
+			floatx8 r=x-fq*floatx8(PIO2_A)-fq*floatx8(PIO2_B)-fq*floatx8(PIO2_C);
+			floatx8 ps=sinPoly(r), pc=cosPoly(r);
+			floatx8 odd(oddMask(q[0]), oddMask(q[1]));
+			s=select(odd, pc, ps);
+			c=select(odd, ps, pc);
+			s=floatx8(flipBy(s.lo, q[0]), flipBy(s.hi, q[1]));
+			__m128i one=_mm_set1_epi32(1);
+			c=floatx8(flipBy(c.lo, _mm_add_epi32(q[0], one)), flipBy(c.hi, _mm_add_epi32(q[1], one)));
+		}
+
+		//abs error under 2e-7.
+		static float sin(float x) { float s, c; sincos(x, s, c); return s; }
+		static floatx8 sin(const floatx8& x) { floatx8 s, c; sincos(x, s, c); return s; }
+
+		//abs error under 2e-7.
+		static float cos(float x) { float s, c; sincos(x, s, c); return c; }
+		static floatx8 cos(const floatx8& x) { floatx8 s, c; sincos(x, s, c); return c; }
+
+		//angle of (x, y) in [-pi, pi], abs error under 2e-6. atan2(0, 0) is 0.
+		static float atan2(float y, float x) {
+			float ax=fabsf(x), ay=fabsf(y);
+			float mx=ax>ay?ax:ay, mn=ax>ay?ay:ax;
+			float a=mx==0?0:mn/mx;
+			float r=atanPoly(a);
+			if (ay>ax) r=1.57079633f-r;
+			if (x<0) r=3.14159265f-r;
+			return y<0?-r:r;
+		}
+
+		static floatx8 atan2(const floatx8& y, const floatx8& x) {
+			floatx8 absMask(_mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF)), _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF)));
+			floatx8 ax=x&absMask, ay=y&absMask;
+			floatx8 mx=vmax(ax, ay), mn=vmin(ax, ay);
+			floatx8 zero;
+			floatx8 a=select(mx==zero, zero, mn/mx);
+			floatx8 r=atanPoly(a);
+			r=select(ay>ax, floatx8(1.57079633f)-r, r);
+			r=select(x<zero, floatx8(3.14159265f)-r, r);
+			return select(y<zero, -r, r);
+		}
+
+		//1/sqrt, rel error under 4e-7. not defined at 0.
+		static float rsqrt(float x) { return displib::rsqrt(x); }
+		static floatx8 rsqrt(const floatx8& x) { return displib::rsqrt(x); }
+
+		//sqrt as x*rsqrt, rel error under 3e-7. 0 at 0.
+		//scalar sqrtf is already one instruction, this pays off 8 wide.
+		static float sqrt(float x) { return x==0?0:x*displib::rsqrt(x); }
+		static floatx8 sqrt(const floatx8& x) {
+			floatx8 zero;
+			return select(x==zero, zero, x*displib::rsqrt(x));
+		}
+	};
+}
@@ -1,4 +1,5 @@
 #include "Maths.h"
+#include "Random.h"
 
 namespace displib {
 	//simple constants
@@ -47,7 +48,7 @@ namespace displib {
 	}
 
 	float Maths::random() {
-		return rand()/(float)RAND_MAX;
+		return Random::local().nextFloat();
 	}
 
 	float Maths::random(float f) {
@@ -9,6 +9,9 @@ namespace displib {
 		public:
 		static const float PI, TAU, E;
 
+		//polynomial trig and sqrt, in Fast.h.
+		class fast;
+
 		//returns value "percent(0-1)" between a and b.
 		static float lerp(float t, float a, float b);
 
@@ -27,7 +30,7 @@ namespace displib {
 		//snaps a to nearest stepped b value.
 		static float snapTo(float a, float b);
 
-		//returns random val in range(0, 1).
+		//returns random val in range(0, 1), from the calling thread's stream.
 		static float random();
 
 		//returns random val in range(0, f).
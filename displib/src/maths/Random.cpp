@@ -0,0 +1,218 @@
+#include "Random.h"
+
+#include <atomic>
+#include <cmath>
+#include <emmintrin.h>
+
+namespace displib {
+	static const float TAU=6.2831853f;
+
+	//spreads a seed into well mixed state words
+	static uint64_t splitMix(uint64_t& x) {
+		uint64_t z=(x+=0x9E3779B97F4A7C15ull);
+		z=(z^(z>>30))*0xBF58476D1CE4E5B9ull;
+		z=(z^(z>>27))*0x94D049BB133111EBull;
+		return z^(z>>31);
+	}
+
+	static inline uint32_t rotl(uint32_t x, int k) {
+		return (x<<k)|(x>>(32-k));
+	}
+
+	static uint32_t step(uint32_t* s) {
+		uint32_t result=rotl(s[1]*5, 7)*9;
+		uint32_t t=s[1]<<9;
+		s[2]^=s[0];
+		s[3]^=s[1];
+		s[1]^=s[2];
+		s[0]^=s[3];
+		s[2]^=t;
+		s[3]=rotl(s[3], 11);
+		return result;
+	}
+
+	static void jumpState(uint32_t* s) {
+		static const uint32_t JUMP[4]={0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b};
+		uint32_t j[4]={0, 0, 0, 0};
+		for (int i=0; i<4; i++) {
+			for (int b=0; b<32; b++) {
+				if (JUMP[i]&(1u<<b)) {
+					for (int k=0; k<4; k++) j[k]^=s[k];
+				}
+				step(s);
+			}
+		}
+		for (int k=0; k<4; k++) s[k]=j[k];
+	}
+
+	//sse2 has no 32 bit multiply, 5 and 9 are a shift and an add
+	static inline __m128i rotl4(__m128i x, int k) {
+		return _mm_or_si128(_mm_slli_epi32(x, k), _mm_srli_epi32(x, 32-k));
+	}
+
+	static inline __m128i step4(__m128i* s) {
+		__m128i s1x5=_mm_add_epi32(_mm_slli_epi32(s[1], 2), s[1]);
+		__m128i r=rotl4(s1x5, 7);
+		__m128i result=_mm_add_epi32(_mm_slli_epi32(r, 3), r);
+		__m128i t=_mm_slli_epi32(s[1], 9);
+		s[2]=_mm_xor_si128(s[2], s[0]);
+		s[3]=_mm_xor_si128(s[3], s[1]);
+		s[1]=_mm_xor_si128(s[1], s[2]);
+		s[0]=_mm_xor_si128(s[0], s[3]);
+		s[2]=_mm_xor_si128(s[2], t);
+		s[3]=rotl4(s[3], 11);
+		return result;
+	}
+
+	//top 24 bits, exact in a float
+	static inline __m128 toFloat4(__m128i x) {
+		return _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(x, 8)), _mm_set1_ps(1.f/16777216));
+	}
+
+	Random::Random() {
+		this->setSeed(0);
+	}
+
+	Random::Random(uint64_t seed) {
+		this->setSeed(seed);
+	}
+
+	void Random::setSeed(uint64_t seed) {
+		uint64_t x=seed;
+		for (int i=0; i<4; i+=2) {
+			uint64_t z=splitMix(x);
+			this->state[i]=(uint32_t)z;
+			this->state[i+1]=(uint32_t)(z>>32);
+		}
+		//lanes carry on from the same mixer, all zero state is impossible
+		for (int l=0; l<4; l++) {
+			for (int i=0; i<4; i+=2) {
+				uint64_t z=splitMix(x);
+				this->lanes[i][l]=(uint32_t)z;
+				this->lanes[i+1][l]=(uint32_t)(z>>32);
+			}
+		}
+	}
+
+	void Random::jump() {
+		jumpState(this->state);
+		for (int l=0; l<4; l++) {
+			uint32_t s[4]={this->lanes[0][l], this->lanes[1][l], this->lanes[2][l], this->lanes[3][l]};
+			jumpState(s);
+			for (int i=0; i<4; i++) this->lanes[i][l]=s[i];
+		}
+	}
+
+	uint32_t Random::next() {
+		return step(this->state);
+	}
+
+	float Random::nextFloat() {
+		return (this->next()>>8)*(1.f/16777216);
+	}
+
+	float Random::nextFloat(float a, float b) {
+		return a+(b-a)*this->nextFloat();
+	}
+
+	int Random::nextInt(int n) {
+		//top bits scaled, no modulo bias worth caring about
+		return (int)(((uint64_t)this->next()*(uint32_t)n)>>32);
+	}
+
+	float Random::nextGaussian() {
+		//box muller, 1-u keeps log away from 0
+		float u=1-this->nextFloat();
+		float v=this->nextFloat();
+		return sqrtf(-2*logf(u))*cosf(TAU*v);
+	}
+
+	void Random::fillUniform(float* out, int n) {
+		__m128i s[4];
+		for (int k=0; k<4; k++) s[k]=_mm_loadu_si128((const __m128i*)this->lanes[k]);
+
+		int i=0;
+		for (; i+4<=n; i+=4) _mm_storeu_ps(out+i, toFloat4(step4(s)));
+		if (i<n) {
+			float tmp[4];
+			_mm_storeu_ps(tmp, toFloat4(step4(s)));
+			for (int k=0; i<n; k++, i++) out[i]=tmp[k];
+		}
+
+		for (int k=0; k<4; k++) _mm_storeu_si128((__m128i*)this->lanes[k], s[k]);
+	}
+
+	void Random::fillUniform(float* out, int n, float a, float b) {
+		this->fillUniform(out, n);
+		__m128 a4=_mm_set1_ps(a), d4=_mm_set1_ps(b-a);
+		int i=0;
+		for (; i+4<=n; i+=4) _mm_storeu_ps(out+i, _mm_add_ps(a4, _mm_mul_ps(d4, _mm_loadu_ps(out+i))));
+		for (; i<n; i++) out[i]=a+(b-a)*out[i];
+	}
+
+	void Random::fillGaussian(float* out, int n, float mean, float dev) {
+		//uniforms in bulk, then box muller gives two normals per pair
+		this->fillUniform(out, n);
+		int i=0;
+		for (; i+2<=n; i+=2) {
+			float r=sqrtf(-2*logf(1-out[i]))*dev;
+			float t=TAU*out[i+1];
+			out[i]=mean+r*cosf(t);
+			out[i+1]=mean+r*sinf(t);
+		}
+		if (i<n) out[i]=mean+this->nextGaussian()*dev;
+	}
+
+	void Random::fillUnit(float* xs, float* ys, int n) {
+		//angles in bulk into xs
+		this->fillUniform(xs, n);
+		for (int i=0; i<n; i++) {
+			float t=TAU*xs[i];
+			xs[i]=cosf(t);
+			ys[i]=sinf(t);
+		}
+	}
+
+	void Random::fillUnit(float* xs, float* ys, float* zs, int n) {
+		//uniform z and angle round it is uniform on the sphere
+		this->fillUniform(xs, n);
+		this->fillUniform(zs, n, -1, 1);
+		for (int i=0; i<n; i++) {
+			float t=TAU*xs[i];
+			float r=sqrtf(1-zs[i]*zs[i]);
+			xs[i]=r*cosf(t);
+			ys[i]=r*sinf(t);
+		}
+	}
+
+	static std::atomic<uint64_t> sharedSeed(0);
+	//bumped by seed, a thread whose stream is older makes it again
+	static std::atomic<int> generation(0);
+	static thread_local int localIndex=0, localGeneration=-1;
+
+	Random Random::stream(int i) {
+		Random r(sharedSeed.load());
+		for (int k=0; k<i; k++) r.jump();
+		return r;
+	}
+
+	Random& Random::local() {
+		static thread_local Random rng;
+		int g=generation.load(std::memory_order_relaxed);
+		if (localGeneration!=g) {
+			rng=Random::stream(localIndex);
+			localGeneration=g;
+		}
+		return rng;
+	}
+
+	void Random::setLocalStream(int i) {
+		localIndex=i;
+		localGeneration=-1;
+	}
+
+	void Random::seed(uint64_t s) {
+		sharedSeed=s;
+		generation++;
+	}
+}
@@ -0,0 +1,67 @@
+#include <cstdint>
+
+namespace displib {
+#pragma once
+	//xoshiro128** generator, small and fast with good quality floats.
+	//not shared between threads, each thread gets its own stream from local().
+	class Random {
+		private:
+		uint32_t state[4];
+
+		//4 extra streams stepped side by side for the fill functions, lanes[word][lane].
+		uint32_t lanes[4][4];
+
+		public:
+		//same fixed seed every run.
+		Random();
+
+		Random(uint64_t seed);
+
+		//restarts the stream and the fill lanes from a seed.
+		void setSeed(uint64_t seed);
+
+		//moves the stream 2^64 steps ahead, so copies jumped different amounts never overlap.
+		void jump();
+
+		//raw 32 bits.
+		uint32_t next();
+
+		//returns random val in range[0, 1).
+		float nextFloat();
+
+		//returns random val in range[a, b).
+		float nextFloat(float a, float b);
+
+		//returns random int in range[0, n).
+		int nextInt(int n);
+
+		//normal distribution, mean 0 and deviation 1.
+		float nextGaussian();
+
+		//n random vals in range[0, 1), 4 at a time.
+		void fillUniform(float* out, int n);
+
+		//n random vals in range[a, b).
+		void fillUniform(float* out, int n, float a, float b);
+
+		//n normally distributed vals.
+		void fillGaussian(float* out, int n, float mean=0, float dev=1);
+
+		//n random directions of length 1.
+		void fillUnit(float* xs, float* ys, int n);
+		void fillUnit(float* xs, float* ys, float* zs, int n);
+
+		//the shared seed jumped i times, the same for a given i and seed whatever thread asks.
+		static Random stream(int i);
+
+		//the calling thread's stream, stream(i) for the index setLocalStream gave it, 0 by default.
+		//task graph workers take their slot+1, so the main thread keeps 0.
+		static Random& local();
+
+		//picks which stream local() gives this thread, restarting it.
+		static void setLocalStream(int i);
+
+		//sets the shared seed, every thread restarts its stream on its next local().
+		static void seed(uint64_t s);
+	};
+}
@@ -0,0 +1,104 @@
+#include <vector>
+
+#include "float2x8.h"
+#include "float3x8.h"
+
+namespace displib {
+#pragma once
+	//float2s stored as one array per component.
+	//storage is padded to a multiple of 8 so batches never read off the end.
+	class float2Array {
+		private:
+		std::vector<float> xs, ys;
+		int count=0;
+
+		public:
+		float2Array() {}
+
+		float2Array(int n) { this->resize(n); }
+
+		int size() const { return this->count; }
+
+		//size rounded up to whole batches.
+		int paddedSize() const { return (int)this->xs.size(); }
+
+		//new elements are zero.
+		void resize(int n) {
+			this->count=n;
+			int padded=(n+7)&~7;
+			this->xs.resize(padded, 0);
+			this->ys.resize(padded, 0);
+		}
+
+		void push_back(float2 v) {
+			this->resize(this->count+1);
+			this->set(this->count-1, v);
+		}
+
+		float2 get(int i) const { return float2(this->xs[i], this->ys[i]); }
+
+		void set(int i, float2 v) { this->xs[i]=v.x; this->ys[i]=v.y; }
+
+		//batch starting at i, i should be a multiple of 8.
+		float2x8 load8(int i) const { return float2x8::load(&this->xs[i], &this->ys[i]); }
+
+		//padding lanes past size are written too, they are never read back by get.
+		void store8(int i, const float2x8& v) { v.store(&this->xs[i], &this->ys[i]); }
+
+		//raw component arrays, paddedSize long.
+		float* x() { return this->xs.data(); }
+		float* y() { return this->ys.data(); }
+		const float* x() const { return this->xs.data(); }
+		const float* y() const { return this->ys.data(); }
+	};
+
+	//float3s stored as one array per component.
+	//storage is padded to a multiple of 8 so batches never read off the end.
+	class float3Array {
+		private:
+		std::vector<float> xs, ys, zs;
+		int count=0;
+
+		public:
+		float3Array() {}
+
+		float3Array(int n) { this->resize(n); }
+
+		int size() const { return this->count; }
+
+		//size rounded up to whole batches.
+		int paddedSize() const { return (int)this->xs.size(); }
+
+		//new elements are zero.
+		void resize(int n) {
+			this->count=n;
+			int padded=(n+7)&~7;
+			this->xs.resize(padded, 0);
+			this->ys.resize(padded, 0);
+			this->zs.resize(padded, 0);
+		}
+
+		void push_back(float3 v) {
+			this->resize(this->count+1);
+			this->set(this->count-1, v);
+		}
+
+		float3 get(int i) const { return float3(this->xs[i], this->ys[i], this->zs[i]); }
+
+		void set(int i, float3 v) { this->xs[i]=v.x; this->ys[i]=v.y; this->zs[i]=v.z; }
+
+		//batch starting at i, i should be a multiple of 8.
+		float3x8 load8(int i) const { return float3x8::load(&this->xs[i], &this->ys[i], &this->zs[i]); }
+
+		//padding lanes past size are written too, they are never read back by get.
+		void store8(int i, const float3x8& v) { v.store(&this->xs[i], &this->ys[i], &this->zs[i]); }
+
+		//raw component arrays, paddedSize long.
+		float* x() { return this->xs.data(); }
+		float* y() { return this->ys.data(); }
+		float* z() { return this->zs.data(); }
+		const float* x() const { return this->xs.data(); }
+		const float* y() const { return this->ys.data(); }
+		const float* z() const { return this->zs.data(); }
+	};
+}
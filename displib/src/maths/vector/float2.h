@@ -1,66 +1,76 @@
-#include <cmath>
+#include "scalar.h"
 
 namespace displib {
 #pragma once
 	struct float2 {
 		float x, y;
 
-		float2();
+		constexpr float2() : x(0), y(0) {}
 
-		float2(float f);
+		constexpr float2(float f) : x(f), y(f) {}
 
-		float2(float x_, float y_);
+		constexpr float2(float x_, float y_) : x(x_), y(y_) {}
 
 		//vector check
-		bool operator==(float2 v);
+		constexpr bool operator==(float2 v) const { return x==v.x&&y==v.y; }
 
 		//vector set
-		void operator=(float2 v);
-		void operator=(float f);
+		float2& operator=(const float2& v)=default;
+		float2& operator=(float f) { x=y=f; return *this; }
 
 		//vector add then set
-		void operator+=(float2 v);
-		void operator+=(float f);
+		float2& operator+=(float2 v) { x+=v.x; y+=v.y; return *this; }
+		float2& operator+=(float f) { x+=f; y+=f; return *this; }
 
 		//vector subtract then set
-		void operator-=(float2 v);
-		void operator-=(float f);
+		float2& operator-=(float2 v) { x-=v.x; y-=v.y; return *this; }
+		float2& operator-=(float f) { x-=f; y-=f; return *this; }
 
 		//vector multiply then set
-		void operator*=(float2 v);
-		void operator*=(float f);
+		float2& operator*=(float2 v) { x*=v.x; y*=v.y; return *this; }
+		float2& operator*=(float f) { x*=f; y*=f; return *this; }
 
 		//vector divide then set
-		void operator/=(float2 v);
-		void operator/=(float f);
+		float2& operator/=(float2 v) { x/=v.x; y/=v.y; return *this; }
+		float2& operator/=(float f) { x/=f; y/=f; return *this; }
 	};
 
 	//vector addition
-	float2 operator+(float2 a, float2 b);
-	float2 operator+(float2 v, float f);
-	float2 operator+(float f, float2 v);
+	constexpr float2 operator+(float2 a, float2 b) { return float2(a.x+b.x, a.y+b.y); }
+	constexpr float2 operator+(float2 v, float f) { return float2(v.x+f, v.y+f); }
+	constexpr float2 operator+(float f, float2 v) { return float2(f+v.x, f+v.y); }
 
 	//vector subtraction
-	float2 operator-(float2 a, float2 b);
-	float2 operator-(float2 v, float f);
-	float2 operator-(float f, float2 v);
+	constexpr float2 operator-(float2 a, float2 b) { return float2(a.x-b.x, a.y-b.y); }
+	constexpr float2 operator-(float2 v, float f) { return float2(v.x-f, v.y-f); }
+	constexpr float2 operator-(float f, float2 v) { return float2(f-v.x, f-v.y); }
 
 	//vector multiplication
-	float2 operator*(float2 a, float2 b);
-	float2 operator*(float2 v, float f);
-	float2 operator*(float f, float2 v);
+	constexpr float2 operator*(float2 a, float2 b) { return float2(a.x*b.x, a.y*b.y); }
+	constexpr float2 operator*(float2 v, float f) { return float2(v.x*f, v.y*f); }
+	constexpr float2 operator*(float f, float2 v) { return float2(f*v.x, f*v.y); }
 
 	//vector division
-	float2 operator/(float2 a, float2 b);
-	float2 operator/(float2 v, float f);
-	float2 operator/(float f, float2 v);
+	constexpr float2 operator/(float2 a, float2 b) { return float2(a.x/b.x, a.y/b.y); }
+	constexpr float2 operator/(float2 v, float f) { return float2(v.x/f, v.y/f); }
+	constexpr float2 operator/(float f, float2 v) { return float2(f/v.x, f/v.y); }
 
 	//dot prod of two vecs.
-	float dot(float2 a, float2 b);
+	constexpr float dot(float2 a, float2 b) { return a.x*b.x+a.y*b.y; }
+
+	//squared magnitude of vec, no sqrt.
+	constexpr float lengthSq(float2 v) { return dot(v, v); }
 
 	//scalar magnitude of vec.
-	float length(float2 v);
+	inline float length(float2 v) { return sqrtf(dot(v, v)); }
 
 	//divide all components by length, thus mag is 1.
-	float2 normalize(float2 v);
-}
\ No newline at end of file
+	inline float2 normalize(float2 v) {
+		float l=length(v);
+		return l==0?v:v/l;
+	}
+
+	//a*b+c in one go.
+	constexpr float2 madd(float2 a, float2 b, float2 c) { return float2(a.x*b.x+c.x, a.y*b.y+c.y); }
+	constexpr float2 madd(float2 a, float b, float2 c) { return float2(a.x*b+c.x, a.y*b+c.y); }
+}
@@ -0,0 +1,90 @@
+#include "float2.h"
+#include "floatx8.h"
+
+namespace displib {
+#pragma once
+	//8 float2s in structure of arrays form, same operators as float2.
+	struct float2x8 {
+		floatx8 x, y;
+
+		float2x8() {}
+
+		float2x8(const floatx8& f) : x(f), y(f) {}
+
+		float2x8(const floatx8& x_, const floatx8& y_) : x(x_), y(y_) {}
+
+		//same float2 in every lane.
+		float2x8(float2 v) : x(v.x), y(v.y) {}
+
+		//reads 8 of each component.
+		static float2x8 load(const float* xs, const float* ys) { return float2x8(floatx8::load(xs), floatx8::load(ys)); }
+
+		//reads first n of each component, rest of lanes are 0.
+		static float2x8 loadPartial(const float* xs, const float* ys, int n) { return float2x8(floatx8::loadPartial(xs, n), floatx8::loadPartial(ys, n)); }
+
+		//writes 8 of each component.
+		void store(float* xs, float* ys) const { x.store(xs); y.store(ys); }
+
+		//writes only first n of each component.
+		void storePartial(float* xs, float* ys, int n) const { x.storePartial(xs, n); y.storePartial(ys, n); }
+
+		//single lane, slow.
+		float2 operator[](int i) const { return float2(x[i], y[i]); }
+
+		//vector add then set
+		float2x8& operator+=(const float2x8& v) { x+=v.x; y+=v.y; return *this; }
+		float2x8& operator+=(const floatx8& f) { x+=f; y+=f; return *this; }
+
+		//vector subtract then set
+		float2x8& operator-=(const float2x8& v) { x-=v.x; y-=v.y; return *this; }
+		float2x8& operator-=(const floatx8& f) { x-=f; y-=f; return *this; }
+
+		//vector multiply then set
+		float2x8& operator*=(const float2x8& v) { x*=v.x; y*=v.y; return *this; }
+		float2x8& operator*=(const floatx8& f) { x*=f; y*=f; return *this; }
+
+		//vector divide then set
+		float2x8& operator/=(const float2x8& v) { x/=v.x; y/=v.y; return *this; }
+		float2x8& operator/=(const floatx8& f) { x/=f; y/=f; return *this; }
+	};
+
+	//vector addition
+	inline float2x8 operator+(const float2x8& a, const float2x8& b) { return float2x8(a.x+b.x, a.y+b.y); }
+	inline float2x8 operator+(const float2x8& v, const floatx8& f) { return float2x8(v.x+f, v.y+f); }
+	inline float2x8 operator+(const floatx8& f, const float2x8& v) { return float2x8(f+v.x, f+v.y); }
+
+	//vector subtraction
+	inline float2x8 operator-(const float2x8& a, const float2x8& b) { return float2x8(a.x-b.x, a.y-b.y); }
+	inline float2x8 operator-(const float2x8& v, const floatx8& f) { return float2x8(v.x-f, v.y-f); }
+	inline float2x8 operator-(const floatx8& f, const float2x8& v) { return float2x8(f-v.x, f-v.y); }
+
+	//vector multiplication
+	inline float2x8 operator*(const float2x8& a, const float2x8& b) { return float2x8(a.x*b.x, a.y*b.y); }
+	inline float2x8 operator*(const float2x8& v, const floatx8& f) { return float2x8(v.x*f, v.y*f); }
+	inline float2x8 operator*(const floatx8& f, const float2x8& v) { return float2x8(f*v.x, f*v.y); }
+
+	//vector division
+	inline float2x8 operator/(const float2x8& a, const float2x8& b) { return float2x8(a.x/b.x, a.y/b.y); }
+	inline float2x8 operator/(const float2x8& v, const floatx8& f) { return float2x8(v.x/f, v.y/f); }
+	inline float2x8 operator/(const floatx8& f, const float2x8& v) { return float2x8(f/v.x, f/v.y); }
+
+	//dot prod of two vecs.
+	inline floatx8 dot(const float2x8& a, const float2x8& b) { return a.x*b.x+a.y*b.y; }
+
+	//squared magnitude of vec, no sqrt.
+	inline floatx8 lengthSq(const float2x8& v) { return dot(v, v); }
+
+	//scalar magnitude of vec.
+	inline floatx8 length(const float2x8& v) { return vsqrt(dot(v, v)); }
+
+	//divide all components by length, thus mag is 1. zero vecs stay zero.
+	inline float2x8 normalize(const float2x8& v) {
+		floatx8 l=length(v);
+		floatx8 zero=l==floatx8(0.f);
+		return float2x8(select(zero, v.x, v.x/l), select(zero, v.y, v.y/l));
+	}
+
+	//a*b+c in one go.
+	inline float2x8 madd(const float2x8& a, const float2x8& b, const float2x8& c) { return float2x8(a.x*b.x+c.x, a.y*b.y+c.y); }
+	inline float2x8 madd(const float2x8& a, const floatx8& b, const float2x8& c) { return float2x8(a.x*b+c.x, a.y*b+c.y); }
+}
@@ -1,69 +1,85 @@
-#include <cmath>
+#include "scalar.h"
 
 namespace displib {
 #pragma once
 	struct float3 {
 		float x, y, z;
 
-		float3();
+		constexpr float3() : x(0), y(0), z(0) {}
 
-		float3(float f);
+		constexpr float3(float f) : x(f), y(f), z(f) {}
 
-		float3(float x_, float y_, float z_);
+		constexpr float3(float x_, float y_, float z_) : x(x_), y(y_), z(z_) {}
 
 		//vector check
-		bool operator==(float3 v);
+		constexpr bool operator==(float3 v) const { return x==v.x&&y==v.y&&z==v.z; }
 
 		//vector set
-		void operator=(float3 v);
-		void operator=(float f);
+		float3& operator=(const float3& v)=default;
+		float3& operator=(float f) { x=y=z=f; return *this; }
 
 		//vector add then set
-		void operator+=(float3 v);
-		void operator+=(float f);
+		float3& operator+=(float3 v) { x+=v.x; y+=v.y; z+=v.z; return *this; }
+		float3& operator+=(float f) { x+=f; y+=f; z+=f; return *this; }
 
 		//vector subtract then set
-		void operator-=(float3 v);
-		void operator-=(float f);
+		float3& operator-=(float3 v) { x-=v.x; y-=v.y; z-=v.z; return *this; }
+		float3& operator-=(float f) { x-=f; y-=f; z-=f; return *this; }
 
 		//vector multiply then set
-		void operator*=(float3 v);
-		void operator*=(float f);
+		float3& operator*=(float3 v) { x*=v.x; y*=v.y; z*=v.z; return *this; }
+		float3& operator*=(float f) { x*=f; y*=f; z*=f; return *this; }
 
 		//vector divide then set
-		void operator/=(float3 v);
-		void operator/=(float f);
+		float3& operator/=(float3 v) { x/=v.x; y/=v.y; z/=v.z; return *this; }
+		float3& operator/=(float f) { x/=f; y/=f; z/=f; return *this; }
 	};
 
 	//vector addition
-	float3 operator+(float3 a, float3 b);
-	float3 operator+(float3 v, float f);
-	float3 operator+(float f, float3 v);
+	constexpr float3 operator+(float3 a, float3 b) { return float3(a.x+b.x, a.y+b.y, a.z+b.z); }
+	constexpr float3 operator+(float3 v, float f) { return float3(v.x+f, v.y+f, v.z+f); }
+	constexpr float3 operator+(float f, float3 v) { return float3(f+v.x, f+v.y, f+v.z); }
 
 	//vector subtraction
-	float3 operator-(float3 a, float3 b);
-	float3 operator-(float3 v, float f);
-	float3 operator-(float f, float3 v);
+	constexpr float3 operator-(float3 a, float3 b) { return float3(a.x-b.x, a.y-b.y, a.z-b.z); }
+	constexpr float3 operator-(float3 v, float f) { return float3(v.x-f, v.y-f, v.z-f); }
+	constexpr float3 operator-(float f, float3 v) { return float3(f-v.x, f-v.y, f-v.z); }
 
 	//vector multiplication
-	float3 operator*(float3 a, float3 b);
-	float3 operator*(float3 v, float f);
-	float3 operator*(float f, float3 v);
+	constexpr float3 operator*(float3 a, float3 b) { return float3(a.x*b.x, a.y*b.y, a.z*b.z); }
+	constexpr float3 operator*(float3 v, float f) { return float3(v.x*f, v.y*f, v.z*f); }
+	constexpr float3 operator*(float f, float3 v) { return float3(f*v.x, f*v.y, f*v.z); }
 
 	//vector division
-	float3 operator/(float3 a, float3 b);
-	float3 operator/(float3 v, float f);
-	float3 operator/(float f, float3 v);
+	constexpr float3 operator/(float3 a, float3 b) { return float3(a.x/b.x, a.y/b.y, a.z/b.z); }
+	constexpr float3 operator/(float3 v, float f) { return float3(v.x/f, v.y/f, v.z/f); }
+	constexpr float3 operator/(float f, float3 v) { return float3(f/v.x, f/v.y, f/v.z); }
 
 	//dot prod of two vecs.
-	float dot(float3 a, float3 b);
+	constexpr float dot(float3 a, float3 b) { return a.x*b.x+a.y*b.y+a.z*b.z; }
 
 	//cross prod of two vecs.
-	float3 cross(float3 a, float3 b);
+	constexpr float3 cross(float3 a, float3 b) {
+		return float3(
+			a.y*b.z-a.z*b.y,
+			a.z*b.x-a.x*b.z,
+			a.x*b.y-a.y*b.x
+		);
+	}
+
+	//squared magnitude of vec, no sqrt.
+	constexpr float lengthSq(float3 v) { return dot(v, v); }
 
 	//scalar magnitude of vec.
-	float length(float3 v);
+	inline float length(float3 v) { return sqrtf(dot(v, v)); }
 
 	//divide all components by length, thus mag is 1.
-	float3 normalize(float3 v);
-}
\ No newline at end of file
+	inline float3 normalize(float3 v) {
+		float l=length(v);
+		return l==0?v:v/l;
+	}
+
+	//a*b+c in one go.
+	constexpr float3 madd(float3 a, float3 b, float3 c) { return float3(a.x*b.x+c.x, a.y*b.y+c.y, a.z*b.z+c.z); }
+	constexpr float3 madd(float3 a, float b, float3 c) { return float3(a.x*b+c.x, a.y*b+c.y, a.z*b+c.z); }
+}
@@ -0,0 +1,99 @@
+#include "float3.h"
+#include "floatx8.h"
+
+namespace displib {
+#pragma once
+	//8 float3s in structure of arrays form, same operators as float3.
+	struct float3x8 {
+		floatx8 x, y, z;
+
+		float3x8() {}
+
+		float3x8(const floatx8& f) : x(f), y(f), z(f) {}
+
+		float3x8(const floatx8& x_, const floatx8& y_, const floatx8& z_) : x(x_), y(y_), z(z_) {}
+
+		//same float3 in every lane.
+		float3x8(float3 v) : x(v.x), y(v.y), z(v.z) {}
+
+		//reads 8 of each component.
+		static float3x8 load(const float* xs, const float* ys, const float* zs) { return float3x8(floatx8::load(xs), floatx8::load(ys), floatx8::load(zs)); }
+
+		//reads first n of each component, rest of lanes are 0.
+		static float3x8 loadPartial(const float* xs, const float* ys, const float* zs, int n) { return float3x8(floatx8::loadPartial(xs, n), floatx8::loadPartial(ys, n), floatx8::loadPartial(zs, n)); }
+
+		//writes 8 of each component.
+		void store(float* xs, float* ys, float* zs) const { x.store(xs); y.store(ys); z.store(zs); }
+
+		//writes only first n of each component.
+		void storePartial(float* xs, float* ys, float* zs, int n) const { x.storePartial(xs, n); y.storePartial(ys, n); z.storePartial(zs, n); }
+
+		//single lane, slow.
+		float3 operator[](int i) const { return float3(x[i], y[i], z[i]); }
+
+		//vector add then set
+		float3x8& operator+=(const float3x8& v) { x+=v.x; y+=v.y; z+=v.z; return *this; }
+		float3x8& operator+=(const floatx8& f) { x+=f; y+=f; z+=f; return *this; }
+
+		//vector subtract then set
+		float3x8& operator-=(const float3x8& v) { x-=v.x; y-=v.y; z-=v.z; return *this; }
+		float3x8& operator-=(const floatx8& f) { x-=f; y-=f; z-=f; return *this; }
+
+		//vector multiply then set
+		float3x8& operator*=(const float3x8& v) { x*=v.x; y*=v.y; z*=v.z; return *this; }
+		float3x8& operator*=(const floatx8& f) { x*=f; y*=f; z*=f; return *this; }
+
+		//vector divide then set
+		float3x8& operator/=(const float3x8& v) { x/=v.x; y/=v.y; z/=v.z; return *this; }
+		float3x8& operator/=(const floatx8& f) { x/=f; y/=f; z/=f; return *this; }
+	};
+
+	//vector addition
+	inline float3x8 operator+(const float3x8& a, const float3x8& b) { return float3x8(a.x+b.x, a.y+b.y, a.z+b.z); }
+	inline float3x8 operator+(const float3x8& v, const floatx8& f) { return float3x8(v.x+f, v.y+f, v.z+f); }
+	inline float3x8 operator+(const floatx8& f, const float3x8& v) { return float3x8(f+v.x, f+v.y, f+v.z); }
+
+	//vector subtraction
+	inline float3x8 operator-(const float3x8& a, const float3x8& b) { return float3x8(a.x-b.x, a.y-b.y, a.z-b.z); }
+	inline float3x8 operator-(const float3x8& v, const floatx8& f) { return float3x8(v.x-f, v.y-f, v.z-f); }
+	inline float3x8 operator-(const floatx8& f, const float3x8& v) { return float3x8(f-v.x, f-v.y, f-v.z); }
+
+	//vector multiplication
+	inline float3x8 operator*(const float3x8& a, const float3x8& b) { return float3x8(a.x*b.x, a.y*b.y, a.z*b.z); }
+	inline float3x8 operator*(const float3x8& v, const floatx8& f) { return float3x8(v.x*f, v.y*f, v.z*f); }
+	inline float3x8 operator*(const floatx8& f, const float3x8& v) { return float3x8(f*v.x, f*v.y, f*v.z); }
+
+	//vector division
+	inline float3x8 operator/(const float3x8& a, const float3x8& b) { return float3x8(a.x/b.x, a.y/b.y, a.z/b.z); }
+	inline float3x8 operator/(const float3x8& v, const floatx8& f) { return float3x8(v.x/f, v.y/f, v.z/f); }
+	inline float3x8 operator/(const floatx8& f, const float3x8& v) { return float3x8(f/v.x, f/v.y, f/v.z); }
+
+	//dot prod of two vecs.
+	inline floatx8 dot(const float3x8& a, const float3x8& b) { return a.x*b.x+a.y*b.y+a.z*b.z; }
+
+	//cross prod of two vecs.
+	inline float3x8 cross(const float3x8& a, const float3x8& b) {
+		return float3x8(
+			a.y*b.z-a.z*b.y,
+			a.z*b.x-a.x*b.z,
+			a.x*b.y-a.y*b.x
+		);
+	}
+
+	//squared magnitude of vec, no sqrt.
+	inline floatx8 lengthSq(const float3x8& v) { return dot(v, v); }
+
+	//scalar magnitude of vec.
+	inline floatx8 length(const float3x8& v) { return vsqrt(dot(v, v)); }
+
+	//divide all components by length, thus mag is 1. zero vecs stay zero.
+	inline float3x8 normalize(const float3x8& v) {
+		floatx8 l=length(v);
+		floatx8 zero=l==floatx8(0.f);
+		return float3x8(select(zero, v.x, v.x/l), select(zero, v.y, v.y/l), select(zero, v.z, v.z/l));
+	}
+
+	//a*b+c in one go.
+	inline float3x8 madd(const float3x8& a, const float3x8& b, const float3x8& c) { return float3x8(a.x*b.x+c.x, a.y*b.y+c.y, a.z*b.z+c.z); }
+	inline float3x8 madd(const float3x8& a, const floatx8& b, const float3x8& c) { return float3x8(a.x*b+c.x, a.y*b+c.y, a.z*b+c.z); }
+}
@@ -0,0 +1,103 @@
+#include <cstring>
+#include <emmintrin.h>
+
+namespace displib {
+#pragma once
+	//8 floats worked on together, as two sse registers.
+	//passed by const ref everywhere, x86 cant pass aligned types by value.
+	struct floatx8 {
+		__m128 lo, hi;
+
+		floatx8() : lo(_mm_setzero_ps()), hi(_mm_setzero_ps()) {}
+
+		floatx8(float f) : lo(_mm_set1_ps(f)), hi(_mm_set1_ps(f)) {}
+
+		floatx8(__m128 lo_, __m128 hi_) : lo(lo_), hi(hi_) {}
+
+		//reads 8 floats, no alignment needed.
+		static floatx8 load(const float* p) { return floatx8(_mm_loadu_ps(p), _mm_loadu_ps(p+4)); }
+
+		//reads first n floats, rest of lanes are 0.
+		static floatx8 loadPartial(const float* p, int n) {
+			float tmp[8]={0};
+			memcpy(tmp, p, sizeof(float)*n);
+			return load(tmp);
+		}
+
+		//lane i holds start+i.
+		static floatx8 ramp(float start) {
+			return floatx8(_mm_setr_ps(start, start+1, start+2, start+3), _mm_setr_ps(start+4, start+5, start+6, start+7));
+		}
+
+		//writes 8 floats, no alignment needed.
+		void store(float* p) const {
+			_mm_storeu_ps(p, lo);
+			_mm_storeu_ps(p+4, hi);
+		}
+
+		//writes only first n floats.
+		void storePartial(float* p, int n) const {
+			float tmp[8];
+			store(tmp);
+			memcpy(p, tmp, sizeof(float)*n);
+		}
+
+		//single lane, slow.
+		float operator[](int i) const {
+			float tmp[8];
+			store(tmp);
+			return tmp[i];
+		}
+
+		floatx8& operator+=(const floatx8& v) { lo=_mm_add_ps(lo, v.lo); hi=_mm_add_ps(hi, v.hi); return *this; }
+		floatx8& operator-=(const floatx8& v) { lo=_mm_sub_ps(lo, v.lo); hi=_mm_sub_ps(hi, v.hi); return *this; }
+		floatx8& operator*=(const floatx8& v) { lo=_mm_mul_ps(lo, v.lo); hi=_mm_mul_ps(hi, v.hi); return *this; }
+		floatx8& operator/=(const floatx8& v) { lo=_mm_div_ps(lo, v.lo); hi=_mm_div_ps(hi, v.hi); return *this; }
+	};
+
+	//lane wise math
+	inline floatx8 operator+(const floatx8& a, const floatx8& b) { return floatx8(_mm_add_ps(a.lo, b.lo), _mm_add_ps(a.hi, b.hi)); }
+	inline floatx8 operator-(const floatx8& a, const floatx8& b) { return floatx8(_mm_sub_ps(a.lo, b.lo), _mm_sub_ps(a.hi, b.hi)); }
+	inline floatx8 operator*(const floatx8& a, const floatx8& b) { return floatx8(_mm_mul_ps(a.lo, b.lo), _mm_mul_ps(a.hi, b.hi)); }
+	inline floatx8 operator/(const floatx8& a, const floatx8& b) { return floatx8(_mm_div_ps(a.lo, b.lo), _mm_div_ps(a.hi, b.hi)); }
+	inline floatx8 operator-(const floatx8& v) { return floatx8()-v; }
+
+	//lane wise compares, all bits set where true.
+	inline floatx8 operator<(const floatx8& a, const floatx8& b) { return floatx8(_mm_cmplt_ps(a.lo, b.lo), _mm_cmplt_ps(a.hi, b.hi)); }
+	inline floatx8 operator>(const floatx8& a, const floatx8& b) { return floatx8(_mm_cmpgt_ps(a.lo, b.lo), _mm_cmpgt_ps(a.hi, b.hi)); }
+	inline floatx8 operator<=(const floatx8& a, const floatx8& b) { return floatx8(_mm_cmple_ps(a.lo, b.lo), _mm_cmple_ps(a.hi, b.hi)); }
+	inline floatx8 operator>=(const floatx8& a, const floatx8& b) { return floatx8(_mm_cmpge_ps(a.lo, b.lo), _mm_cmpge_ps(a.hi, b.hi)); }
+	inline floatx8 operator==(const floatx8& a, const floatx8& b) { return floatx8(_mm_cmpeq_ps(a.lo, b.lo), _mm_cmpeq_ps(a.hi, b.hi)); }
+	inline floatx8 operator&(const floatx8& a, const floatx8& b) { return floatx8(_mm_and_ps(a.lo, b.lo), _mm_and_ps(a.hi, b.hi)); }
+	inline floatx8 operator|(const floatx8& a, const floatx8& b) { return floatx8(_mm_or_ps(a.lo, b.lo), _mm_or_ps(a.hi, b.hi)); }
+
+	//picks a where mask is set, else b.
+	inline floatx8 select(const floatx8& mask, const floatx8& a, const floatx8& b) {
+		return floatx8(
+			_mm_or_ps(_mm_and_ps(mask.lo, a.lo), _mm_andnot_ps(mask.lo, b.lo)),
+			_mm_or_ps(_mm_and_ps(mask.hi, a.hi), _mm_andnot_ps(mask.hi, b.hi))
+		);
+	}
+
+	//bit i set if lane i of mask is set.
+	inline int moveMask(const floatx8& mask) { return _mm_movemask_ps(mask.lo)|(_mm_movemask_ps(mask.hi)<<4); }
+
+	//v prefixed, windows.h has min/max macros and sqrt would shadow the float one.
+	inline floatx8 vmin(const floatx8& a, const floatx8& b) { return floatx8(_mm_min_ps(a.lo, b.lo), _mm_min_ps(a.hi, b.hi)); }
+	inline floatx8 vmax(const floatx8& a, const floatx8& b) { return floatx8(_mm_max_ps(a.lo, b.lo), _mm_max_ps(a.hi, b.hi)); }
+	inline floatx8 vsqrt(const floatx8& v) { return floatx8(_mm_sqrt_ps(v.lo), _mm_sqrt_ps(v.hi)); }
+
+	//approximate 1/sqrt, estimate refined with one newton step.
+	inline floatx8 rsqrt(const floatx8& v) {
+		floatx8 r(_mm_rsqrt_ps(v.lo), _mm_rsqrt_ps(v.hi));
+		return r*(floatx8(1.5f)-floatx8(0.5f)*v*r*r);
+	}
+
+	//sum of all lanes.
+	inline float hsum(const floatx8& v) {
+		__m128 s=_mm_add_ps(v.lo, v.hi);
+		s=_mm_add_ps(s, _mm_movehl_ps(s, s));
+		s=_mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+		return _mm_cvtss_f32(s);
+	}
+}
@@ -0,0 +1,11 @@
+#include <cmath>
+#include <xmmintrin.h>
+
+namespace displib {
+#pragma once
+	//approximate 1/sqrt(f), sse estimate refined with one newton step.
+	inline float rsqrt(float f) {
+		float r=_mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(f)));
+		return r*(1.5f-0.5f*f*r*r);
+	}
+}
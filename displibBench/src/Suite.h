@@ -0,0 +1,90 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "io/Stopwatch.h"
+
+#pragma once
+//collects results as the benchmarks run, prints them as they come and writes them all out as json.
+//the json keeps a fixed layout and order so runs can be diffed and gated on.
+class Suite {
+	public:
+	struct Result {
+		std::string name, params, unit;
+
+		//median and fastest sample.
+		double value, best;
+	};
+
+	std::vector<Result> results;
+
+	//only sections whose name contains this run, empty runs all.
+	std::string filter;
+
+	//fewer, shorter samples.
+	bool quick=false;
+
+	bool wants(const char* section) const {
+		return this->filter.empty()||std::string(section).find(this->filter)!=std::string::npos;
+	}
+
+	//times func as a few samples, each calling it enough times to last a couple ms.
+	//returns the median in ns per op, fastest sample in best.
+	double time(std::function<void()> func, double opsPerCall, double* best=nullptr) {
+		Stopwatch watch;
+		int sampleNs=this->quick?500000:2000000;
+		int reps=1;
+		while (true) {
+			watch.start();
+			for (int i=0; i<reps; i++) func();
+			watch.stop();
+			if (watch.getNanoseconds()>=sampleNs||reps>=(1<<24)) break;
+			reps*=2;
+		}
+
+		int sampleNum=this->quick?3:9;
+		std::vector<double> samples(sampleNum);
+		for (int s=0; s<sampleNum; s++) {
+			watch.start();
+			for (int i=0; i<reps; i++) func();
+			watch.stop();
+			samples[s]=watch.getNanoseconds()/(reps*opsPerCall);
+		}
+		std::sort(samples.begin(), samples.end());
+		if (best) *best=samples[0];
+		return samples[sampleNum/2];
+	}
+
+	//times and records in ns/op.
+	double run(const std::string& name, const std::string& params, double opsPerCall, std::function<void()> func) {
+		double best;
+		double ns=this->time(func, opsPerCall, &best);
+		this->record(name, params, ns, "ns/op", best);
+		return ns;
+	}
+
+	//records a number measured some other way, best defaults to value.
+	void record(const std::string& name, const std::string& params, double value, const std::string& unit, double best=-1) {
+		this->results.push_back({name, params, unit, value, best<0?value:best});
+		//errors and the like are tiny, those get exponents
+		const char* format=value!=0&&fabs(value)<0.01?"  %-28s %-16s %12.3e %s\n":"  %-28s %-16s %12.3f %s\n";
+		printf(format, name.c_str(), params.c_str(), value, unit.c_str());
+	}
+
+	bool writeJSON(const char* path) const {
+		FILE* file=fopen(path, "w");
+		if (!file) return false;
+		fprintf(file, "{\n  \"suite\": \"displibBench\",\n  \"version\": 1,\n  \"results\": [\n");
+		for (size_t i=0; i<this->results.size(); i++) {
+			const Result& r=this->results[i];
+			fprintf(file, "    {\"name\": \"%s\", \"params\": \"%s\", \"unit\": \"%s\", \"value\": %.6g, \"best\": %.6g}%s\n",
+				r.name.c_str(), r.params.c_str(), r.unit.c_str(), r.value, r.best, i+1<this->results.size()?",":"");
+		}
+		fprintf(file, "  ]\n}\n");
+		fclose(file);
+		return true;
+	}
+};
@@ -0,0 +1,668 @@
+//displib micro benchmarks, results are printed as they come and can be written out as json.
+//only needs the console types from windows.h, so it also builds and runs headless, eg on linux
+//g++ -std=c++14 -O2 -Idisplib/src displibBench/src/main.cpp $(find displib/src -name '*.cpp' ! -name Engine.cpp) -lpthread
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "geom/AABBArray.h"
+#include "geom/BVH.h"
+#include "geom/QuadTree.h"
+#include "geom/SpatialHash2D.h"
+#include "maths/Fast.h"
+#include "maths/Random.h"
+#include "maths/vector/float2.h"
+#include "io/Raster.h"
+#include "Suite.h"
+using namespace displib;
+
+//stops the compiler from inlining, like calling into the static lib used to.
+#ifdef _MSC_VER
+#define NOINLINE __declspec(noinline)
+#else
+#define NOINLINE __attribute__((noinline))
+#endif
+
+//the old float2.cpp, one real call per op
+namespace outOfLine {
+	NOINLINE float2 add(float2 a, float2 b) { return a+b; }
+	NOINLINE float2 sub(float2 a, float2 b) { return a-b; }
+	NOINLINE float2 mul(float2 v, float f) { return v*f; }
+	NOINLINE float2 div(float2 v, float f) { return v/f; }
+	NOINLINE float dot(float2 a, float2 b) { return displib::dot(a, b); }
+	NOINLINE float length(float2 v) { return sqrtf(outOfLine::dot(v, v)); }
+	NOINLINE float2 normalize(float2 v) {
+		float l=outOfLine::length(v);
+		return l==0?v:outOfLine::div(v, l);
+	}
+}
+
+struct ptc {
+	float2 pos, vel, force;
+};
+
+struct spr {
+	int a, b;
+	float restLen, stiff, damp;
+};
+
+//clothSim's spr::update, through non inlined calls
+void springsOutOfLine(std::vector<ptc>& ptcs, std::vector<spr>& sprs) {
+	for (spr& s:sprs) {
+		ptc& a=ptcs[s.a];
+		ptc& b=ptcs[s.b];
+		float2 sub=outOfLine::sub(b.pos, a.pos);
+		float2 dir=outOfLine::normalize(sub);
+		float fs=s.stiff*(outOfLine::length(sub)-s.restLen);
+		float fd=outOfLine::dot(dir, outOfLine::sub(b.vel, a.vel))*s.damp;
+		float2 f=outOfLine::mul(dir, fs+fd);
+		a.force=outOfLine::add(a.force, f);
+		b.force=outOfLine::sub(b.force, f);
+	}
+}
+
+//clothSim's spr::update, with the header operators
+void springsInline(std::vector<ptc>& ptcs, std::vector<spr>& sprs) {
+	for (spr& s:sprs) {
+		ptc& a=ptcs[s.a];
+		ptc& b=ptcs[s.b];
+		float2 sub=b.pos-a.pos;
+		float2 dir=normalize(sub);
+		float fs=s.stiff*(length(sub)-s.restLen);
+		float fd=dot(dir, b.vel-a.vel)*s.damp;
+		float2 f=dir*(fs+fd);
+		a.force+=f;
+		b.force-=f;
+	}
+}
+
+//same again, one rsqrt instead of a sqrt and a divide
+void springsFused(std::vector<ptc>& ptcs, std::vector<spr>& sprs) {
+	for (spr& s:sprs) {
+		ptc& a=ptcs[s.a];
+		ptc& b=ptcs[s.b];
+		float2 sub=b.pos-a.pos;
+		float lSq=lengthSq(sub);
+		float inv=lSq==0?0:rsqrt(lSq);
+		float2 dir=sub*inv;
+		float fs=s.stiff*(lSq*inv-s.restLen);
+		float fd=dot(dir, b.vel-a.vel)*s.damp;
+		float2 f=dir*(fs+fd);
+		a.force+=f;
+		b.force=madd(f, -1, b.force);
+	}
+}
+
+//best of a few runs, in ns per spring
+float timeSprings(void(*func)(std::vector<ptc>&, std::vector<spr>&), std::vector<ptc>& ptcs, std::vector<spr>& sprs, int iters) {
+	Stopwatch watch;
+	float best=-1;
+	for (int r=0; r<5; r++) {
+		watch.start();
+		for (int i=0; i<iters; i++) func(ptcs, sprs);
+		watch.stop();
+		float ns=watch.getNanoseconds()/(float)(iters*sprs.size());
+		if (best<0||ns<best) best=ns;
+	}
+	return best;
+}
+
+//one pass of a scalar func over the inputs
+template<typename F>
+void mapScalar(F func, const std::vector<float>& in, std::vector<float>& out) {
+	for (size_t i=0; i<in.size(); i++) out[i]=func(in[i]);
+}
+
+//one pass of an 8 wide func over the inputs, size is a multiple of 8
+template<typename F>
+void mapWide(F func, const std::vector<float>& in, std::vector<float>& out) {
+	for (size_t i=0; i<in.size(); i+=8) func(floatx8::load(&in[i])).store(&out[i]);
+}
+
+//best of a few runs, in ns per element
+template<typename F>
+float timeMap(F pass, size_t n, int iters) {
+	Stopwatch watch;
+	float best=-1;
+	for (int r=0; r<5; r++) {
+		watch.start();
+		for (int i=0; i<iters; i++) pass();
+		watch.stop();
+		float ns=watch.getNanoseconds()/(float)(iters*n);
+		if (best<0||ns<best) best=ns;
+	}
+	return best;
+}
+
+//worst abs or rel difference between two outputs
+float maxError(const std::vector<float>& a, const std::vector<float>& b, bool relative) {
+	float worst=0;
+	for (size_t i=0; i<a.size(); i++) {
+		float e=fabsf(a[i]-b[i]);
+		if (relative) e/=fabsf(b[i]);
+		if (e>worst) worst=e;
+	}
+	return worst;
+}
+
+//libm vs Maths::fast, scalar and 8 wide
+void benchFast(Suite& suite) {
+	size_t n=1<<16;
+	int iters=100;
+	std::vector<float> angles(n), pos(n), ys(n), xs(n);
+	for (size_t i=0; i<n; i++) {
+		angles[i]=-1000+2000*(i+0.5f)/n;
+		pos[i]=0.001f+1000*(i+0.5f)/n;
+		ys[i]=sinf(i*0.37f)*(1+i%7);
+		xs[i]=cosf(i*0.53f)*(1+i%5);
+	}
+	std::vector<float> ref(n), fast(n), wide(n);
+
+	printf("\nMaths::fast vs libm, %d values x %d iters\n", (int)n, iters);
+
+	auto report=[&](const char* name, float refNs, float fastNs, float wideNs, bool relative) {
+		float err=maxError(fast, ref, relative);
+		float wideErr=maxError(wide, ref, relative);
+		std::string key=std::string("fast.")+name;
+		suite.record(key, "libm", refNs, "ns/op");
+		suite.record(key, "scalar", fastNs, "ns/op");
+		suite.record(key, "x8", wideNs, "ns/op");
+		suite.record(key, "max error", err>wideErr?err:wideErr, relative?"rel":"abs");
+	};
+
+	float refNs=timeMap([&] { mapScalar([](float x) { return sinf(x); }, angles, ref); }, n, iters);
+	float fastNs=timeMap([&] { mapScalar([](float x) { return Maths::fast::sin(x); }, angles, fast); }, n, iters);
+	float wideNs=timeMap([&] { mapWide([](const floatx8& x) { return Maths::fast::sin(x); }, angles, wide); }, n, iters);
+	report("sin", refNs, fastNs, wideNs, false);
+
+	refNs=timeMap([&] { mapScalar([](float x) { return cosf(x); }, angles, ref); }, n, iters);
+	fastNs=timeMap([&] { mapScalar([](float x) { return Maths::fast::cos(x); }, angles, fast); }, n, iters);
+	wideNs=timeMap([&] { mapWide([](const floatx8& x) { return Maths::fast::cos(x); }, angles, wide); }, n, iters);
+	report("cos", refNs, fastNs, wideNs, false);
+
+	refNs=timeMap([&] { for (size_t i=0; i<n; i++) ref[i]=atan2f(ys[i], xs[i]); }, n, iters);
+	fastNs=timeMap([&] { for (size_t i=0; i<n; i++) fast[i]=Maths::fast::atan2(ys[i], xs[i]); }, n, iters);
+	wideNs=timeMap([&] {
+		for (size_t i=0; i<n; i+=8) Maths::fast::atan2(floatx8::load(&ys[i]), floatx8::load(&xs[i])).store(&wide[i]);
+	}, n, iters);
+	report("atan2", refNs, fastNs, wideNs, false);
+
+	refNs=timeMap([&] { mapScalar([](float x) { return 1/sqrtf(x); }, pos, ref); }, n, iters);
+	fastNs=timeMap([&] { mapScalar([](float x) { return Maths::fast::rsqrt(x); }, pos, fast); }, n, iters);
+	wideNs=timeMap([&] { mapWide([](const floatx8& x) { return Maths::fast::rsqrt(x); }, pos, wide); }, n, iters);
+	report("rsqrt", refNs, fastNs, wideNs, true);
+
+	refNs=timeMap([&] { mapScalar([](float x) { return sqrtf(x); }, pos, ref); }, n, iters);
+	fastNs=timeMap([&] { mapScalar([](float x) { return Maths::fast::sqrt(x); }, pos, fast); }, n, iters);
+	wideNs=timeMap([&] { mapWide([](const floatx8& x) { return Maths::fast::sqrt(x); }, pos, wide); }, n, iters);
+	report("sqrt", refNs, fastNs, wideNs, true);
+}
+
+//rebuild plus all pairs, for n points moving about a square that keeps density fixed
+void benchSpatialHash(Suite& suite) {
+	printf("\nSpatialHash2D rebuild + forEachPair, 1.6 points per cell\n");
+	Random rng(1);
+	for (int n:{1000, 10000, 100000}) {
+		float side=sqrtf(n/0.1f);
+		std::vector<float2> pts(n), vels(n);
+		for (int i=0; i<n; i++) {
+			pts[i]=float2(rng.nextFloat(0, side), rng.nextFloat(0, side));
+			vels[i]=float2(rng.nextFloat(-1, 1), rng.nextFloat(-1, 1));
+		}
+
+		SpatialHash2D grid(4);
+		int frames=20;
+		long pairs=0;
+		Stopwatch watch;
+		watch.start();
+		for (int f=0; f<frames; f++) {
+			for (int i=0; i<n; i++) pts[i]+=vels[i]*0.1f;
+			grid.rebuild(pts.data(), n);
+			grid.forEachPair(4, [&](int, int) { pairs++; });
+		}
+		watch.stop();
+
+		std::string params="n="+std::to_string(n);
+		suite.record("spatialHash.frame", params, watch.getMicroseconds()/1e3/frames, "ms/frame");
+		suite.record("spatialHash.pairs", params, (double)(pairs/frames), "pairs");
+	}
+}
+
+struct benchTri {
+	float3 a, b, c;
+};
+
+//moller trumbore, tMax if missed
+float rayTri(const benchTri& t, float3 o, float3 d, float tMax) {
+	float3 e1=t.b-t.a, e2=t.c-t.a;
+	float3 p=cross(d, e2);
+	float det=dot(e1, p);
+	if (fabsf(det)<1e-9f) return tMax;
+	float inv=1/det;
+	float3 s=o-t.a;
+	float u=dot(s, p)*inv;
+	if (u<0||u>1) return tMax;
+	float3 q=cross(s, e1);
+	float v=dot(d, q)*inv;
+	if (v<0||u+v>1) return tMax;
+	float hit=dot(e2, q)*inv;
+	return hit>0&&hit<tMax?hit:tMax;
+}
+
+//build, refit and closest hit rays over n random tris
+void benchBVH(Suite& suite) {
+	int n=suite.quick?100000:1000000;
+	Random rng(2);
+	std::vector<benchTri> tris(n);
+	std::vector<AABB3D> boxes(n);
+	auto boxOf=[](const benchTri& t) {
+		AABB3D b=AABB3D::empty();
+		b.expand(t.a);
+		b.expand(t.b);
+		b.expand(t.c);
+		return b;
+	};
+	for (int i=0; i<n; i++) {
+		float3 p(rng.nextFloat(0, 100), rng.nextFloat(0, 100), rng.nextFloat(0, 100));
+		auto jitter=[&] { return float3(rng.nextFloat(-0.5f, 0.5f), rng.nextFloat(-0.5f, 0.5f), rng.nextFloat(-0.5f, 0.5f)); };
+		tris[i]={p+jitter(), p+jitter(), p+jitter()};
+		boxes[i]=boxOf(tris[i]);
+	}
+
+	printf("\nBVH over %d random tris\n", n);
+	BVH bvh;
+	Stopwatch watch;
+	watch.start();
+	bvh.build(boxes.data(), n);
+	watch.stop();
+	std::string params="n="+std::to_string(n);
+	suite.record("bvh.build", params, watch.getMicroseconds()/1e3, "ms");
+	suite.record("bvh.nodes", params, (double)bvh.nodes.size(), "nodes");
+
+	//rays from inside the cube out in all directions
+	int rayNum=100000;
+	std::vector<float3> origins(rayNum), dirs(rayNum);
+	for (int i=0; i<rayNum; i++) {
+		origins[i]=float3(rng.nextFloat(0, 100), rng.nextFloat(0, 100), rng.nextFloat(0, 100));
+		float x, y, z;
+		rng.fillUnit(&x, &y, &z, 1);
+		dirs[i]=float3(x, y, z);
+	}
+	std::vector<float> hits(rayNum);
+	auto trace=[&](int i) {
+		return bvh.traceRay(origins[i], dirs[i], INFINITY, [&](int p, float tMax) { return rayTri(tris[p], origins[i], dirs[i], tMax); });
+	};
+	watch.start();
+	for (int i=0; i<rayNum; i++) hits[i]=trace(i);
+	watch.stop();
+	float rayNs=watch.getMicroseconds()*1e3f/rayNum;
+
+	//brute force on a few to check and compare
+	int bruteNum=20;
+	int wrong=0;
+	watch.start();
+	for (int i=0; i<bruteNum; i++) {
+		float best=INFINITY;
+		for (int t=0; t<n; t++) best=rayTri(tris[t], origins[i], dirs[i], best);
+		if (best!=hits[i]) wrong++;
+	}
+	watch.stop();
+	float bruteNs=watch.getMicroseconds()*1e3f/bruteNum;
+	suite.record("bvh.trace", params, rayNs/1e3, "us/ray");
+	suite.record("bvh.bruteForce", params, bruteNs/1e3, "us/ray");
+	suite.record("bvh.mismatched", params, wrong, "rays");
+
+	//nudge everything like an animation step
+	for (int i=0; i<n; i++) {
+		float3 d(rng.nextFloat(-0.2f, 0.2f), rng.nextFloat(-0.2f, 0.2f), rng.nextFloat(-0.2f, 0.2f));
+		tris[i]={tris[i].a+d, tris[i].b+d, tris[i].c+d};
+		boxes[i]=boxOf(tris[i]);
+	}
+	watch.start();
+	bvh.refit(boxes.data());
+	watch.stop();
+	suite.record("bvh.refit", params, watch.getMicroseconds()/1e3, "ms");
+	watch.start();
+	for (int i=0; i<rayNum; i++) hits[i]=trace(i);
+	watch.stop();
+	suite.record("bvh.traceAfterRefit", params, watch.getMicroseconds()/(double)rayNum, "us/ray");
+}
+
+//all pairs of n boxes, AABB2D::overlapAABB against AABB2DArray 8 at a time
+void benchAABB(Suite& suite) {
+	printf("\nall pairs box overlap\n");
+	Random rng(4);
+	for (int n:{100, 1000, 4000}) {
+		std::vector<AABB2D> boxes(n);
+		AABB2DArray arr(n);
+		for (int i=0; i<n; i++) {
+			float2 c(rng.nextFloat(0, 1000), rng.nextFloat(0, 1000));
+			float r=rng.nextFloat(1, 10);
+			boxes[i]=AABB2D(c-float2(r, r), c+float2(r, r));
+			arr.set(i, boxes[i]);
+		}
+
+		int iters=2000000/n;
+		long scalarPairs=0, batchPairs=0;
+		Stopwatch watch;
+		watch.start();
+		for (int it=0; it<iters; it++) {
+			for (int i=0; i<n; i++) {
+				for (int j=i+1; j<n; j++) {
+					if (boxes[i].overlapAABB(boxes[j])) scalarPairs++;
+				}
+			}
+		}
+		watch.stop();
+		float scalarUs=watch.getMicroseconds()/(float)iters;
+
+		watch.start();
+		for (int it=0; it<iters; it++) arr.forEachPair([&](int, int) { batchPairs++; });
+		watch.stop();
+		float batchUs=watch.getMicroseconds()/(float)iters;
+
+		std::string params="n="+std::to_string(n);
+		suite.record("aabb.allPairs", params+" scalar", scalarUs, "us");
+		suite.record("aabb.allPairs", params+" batch", batchUs, "us");
+		suite.record("aabb.mismatched", params, (double)(scalarPairs-batchPairs), "pairs");
+	}
+}
+
+//the pointer quadtree the quadtree demo used to have, with a destructor added so the bench doesn't leak
+namespace pointerTree {
+	template<class T>
+	void addAll(std::vector<T>& a, const std::vector<T>& b) {
+		a.insert(a.end(), b.begin(), b.end());
+	}
+
+	struct quadTree {
+		const int cap=1;
+		AABB2D bounds;
+		std::vector<float2> points;
+
+		quadTree* northWest=nullptr;
+		quadTree* northEast=nullptr;
+		quadTree* southWest=nullptr;
+		quadTree* southEast=nullptr;
+
+		quadTree(AABB2D bounds_) {
+			bounds=bounds_;
+		}
+
+		~quadTree() {
+			delete northWest;
+			delete northEast;
+			delete southWest;
+			delete southEast;
+		}
+
+		void subdivide() {
+			float2 ctr=(bounds.min+bounds.max)/2;
+			northWest=new quadTree(AABB2D(bounds.min, ctr));
+			northEast=new quadTree(AABB2D(float2(ctr.x, bounds.min.y), float2(bounds.max.x, ctr.y)));
+			southWest=new quadTree(AABB2D(float2(bounds.min.x, ctr.y), float2(ctr.x, bounds.max.y)));
+			southEast=new quadTree(AABB2D(ctr, bounds.max));
+		}
+
+		bool insert(float2 pt) {
+			if (!bounds.containsPt(pt))
+				return false;
+
+			if (northWest==nullptr) {
+				if ((int)points.size()<cap) {
+					points.push_back(pt);
+					return true;
+				}
+				subdivide();
+			}
+
+			if (northWest->insert(pt)) return true;
+			if (northEast->insert(pt)) return true;
+			if (southWest->insert(pt)) return true;
+			if (southEast->insert(pt)) return true;
+
+			return false;
+		}
+
+		std::vector<float2> queryRange(AABB2D range) {
+			std::vector<float2> pts;
+			if (!bounds.overlapAABB(range))
+				return pts;
+
+			for (float2& pt:points) {
+				if (range.containsPt(pt)) pts.push_back(pt);
+			}
+
+			if (northWest==nullptr) return pts;
+
+			addAll(pts, northWest->queryRange(range));
+			addAll(pts, northEast->queryRange(range));
+			addAll(pts, southWest->queryRange(range));
+			addAll(pts, southEast->queryRange(range));
+
+			return pts;
+		}
+	};
+}
+
+//build, range and nearest queries, then removal, old pointer tree against QuadTree
+void benchQuadTree(Suite& suite) {
+	int n=suite.quick?100000:1000000;
+	float side=1000;
+	Random rng(3);
+	std::vector<float2> pts(n);
+	for (int i=0; i<n; i++) pts[i]=float2(rng.nextFloat(0, side), rng.nextFloat(0, side));
+	AABB2D bounds(0, 0, side, side);
+
+	int queryNum=10000;
+	std::vector<AABB2D> ranges(queryNum);
+	for (int i=0; i<queryNum; i++) {
+		float2 c(rng.nextFloat(0, side), rng.nextFloat(0, side));
+		ranges[i]=AABB2D(c-float2(5, 5), c+float2(5, 5));
+	}
+
+	printf("\nquadtree over %d random points\n", n);
+	Stopwatch watch;
+
+	long oldFound=0;
+	float oldInsertMs, oldQueryUs;
+	{
+		watch.start();
+		pointerTree::quadTree* old=new pointerTree::quadTree(bounds);
+		for (int i=0; i<n; i++) old->insert(pts[i]);
+		watch.stop();
+		oldInsertMs=watch.getMicroseconds()/1e3f;
+
+		watch.start();
+		for (const AABB2D& r:ranges) oldFound+=old->queryRange(r).size();
+		watch.stop();
+		oldQueryUs=watch.getMicroseconds()/(float)queryNum;
+		delete old;
+	}
+
+	QuadTree tree(bounds, 8);
+	watch.start();
+	for (int i=0; i<n; i++) tree.insert(pts[i], i);
+	watch.stop();
+	float insertMs=watch.getMicroseconds()/1e3f;
+
+	watch.start();
+	tree.build(pts.data(), nullptr, n);
+	watch.stop();
+	float buildMs=watch.getMicroseconds()/1e3f;
+
+	long found=0;
+	watch.start();
+	for (const AABB2D& r:ranges) tree.queryRange(r, [&](float2, int) { found++; });
+	watch.stop();
+	float queryUs=watch.getMicroseconds()/(float)queryNum;
+
+	std::string params="n="+std::to_string(n);
+	suite.record("quadTree.insert", params+" pointer", oldInsertMs, "ms");
+	suite.record("quadTree.insert", params+" pooled", insertMs, "ms");
+	suite.record("quadTree.build", params, buildMs, "ms");
+	suite.record("quadTree.range", params+" pointer", oldQueryUs, "us");
+	suite.record("quadTree.range", params+" pooled", queryUs, "us");
+	suite.record("quadTree.rangeMismatched", params, (double)(found-oldFound), "points");
+
+	//8 nearest, checked against brute force on a few
+	int knnNum=100000;
+	float sumDist=0;
+	watch.start();
+	for (int i=0; i<knnNum; i++) {
+		float2 p=ranges[i%queryNum].min+float2(5, 5);
+		tree.kNearest(p, 8, [&](float2, int, float d) { sumDist+=d; });
+	}
+	watch.stop();
+	float knnUs=watch.getMicroseconds()/(float)knnNum;
+	int wrong=0;
+	for (int i=0; i<20; i++) {
+		float2 p=ranges[i].min+float2(5, 5);
+		float best[8];
+		for (int j=0; j<8; j++) best[j]=INFINITY;
+		for (int j=0; j<n; j++) {
+			float2 d=pts[j]-p;
+			float dSq=d.x*d.x+d.y*d.y;
+			for (int k=0; k<8; k++) {
+				if (dSq<best[k]) {
+					for (int m=7; m>k; m--) best[m]=best[m-1];
+					best[k]=dSq;
+					break;
+				}
+			}
+		}
+		int k=0;
+		tree.kNearest(p, 8, [&](float2, int, float d) { if (d!=best[k++]) wrong++; });
+	}
+	suite.record("quadTree.nearest8", params, knnUs, "us");
+	suite.record("quadTree.nearestMismatched", params, wrong, "queries");
+
+	watch.start();
+	for (int i=0; i<n; i+=2) tree.remove(pts[i], i);
+	watch.stop();
+	float removeMs=watch.getMicroseconds()/1e3f;
+	watch.start();
+	tree.rebalance();
+	watch.stop();
+	suite.record("quadTree.removeHalf", params, removeMs, "ms");
+	suite.record("quadTree.rebalance", params, watch.getMicroseconds()/1e3, "ms");
+}
+
+//clothSim's springs three ways
+void benchSprings(Suite& suite) {
+	//cloth grid like clothSim, springs to the right and below
+	int w=64, h=64;
+	std::vector<ptc> ptcs(w*h);
+	std::vector<spr> sprs;
+	for (int i=0; i<w; i++) {
+		for (int j=0; j<h; j++) {
+			ptcs[i+j*w].pos=float2(i*1.1f, j*0.9f);
+			ptcs[i+j*w].vel=float2((i%3)*0.1f, (j%5)*0.1f);
+			if (i<w-1) sprs.push_back({i+j*w, i+1+j*w, 1, 30, 0.5f});
+			if (j<h-1) sprs.push_back({i+j*w, i+(j+1)*w, 1, 30, 0.5f});
+		}
+	}
+
+	int iters=200;
+	printf("spring update, %d springs x %d iters\n", (int)sprs.size(), iters);
+	std::string params="n="+std::to_string(sprs.size());
+	suite.record("springs.outOfLine", params, timeSprings(springsOutOfLine, ptcs, sprs, iters), "ns/spring");
+	suite.record("springs.inline", params, timeSprings(springsInline, ptcs, sprs, iters), "ns/spring");
+	suite.record("springs.fused", params, timeSprings(springsFused, ptcs, sprs, iters), "ns/spring");
+}
+
+//float2 and float3 operators over arrays, ns per element
+void benchVector(Suite& suite) {
+	int n=4096;
+	printf("\nvector ops over %d elements\n", n);
+	Random rng(5);
+	std::vector<float2> a2(n), b2(n), out2(n);
+	std::vector<float3> a3(n), b3(n), out3(n);
+	std::vector<float> outF(n);
+	for (int i=0; i<n; i++) {
+		a2[i]=float2(rng.nextFloat(-1, 1), rng.nextFloat(-1, 1));
+		b2[i]=float2(rng.nextFloat(-1, 1), rng.nextFloat(-1, 1));
+		a3[i]=float3(rng.nextFloat(-1, 1), rng.nextFloat(-1, 1), rng.nextFloat(-1, 1));
+		b3[i]=float3(rng.nextFloat(-1, 1), rng.nextFloat(-1, 1), rng.nextFloat(-1, 1));
+	}
+
+	suite.run("float2.add", "", n, [&] { for (int i=0; i<n; i++) out2[i]=a2[i]+b2[i]; });
+	suite.run("float2.mulScalar", "", n, [&] { for (int i=0; i<n; i++) out2[i]=a2[i]*1.5f; });
+	suite.run("float2.dot", "", n, [&] { for (int i=0; i<n; i++) outF[i]=dot(a2[i], b2[i]); });
+	suite.run("float2.length", "", n, [&] { for (int i=0; i<n; i++) outF[i]=length(a2[i]); });
+	suite.run("float2.normalize", "", n, [&] { for (int i=0; i<n; i++) out2[i]=normalize(a2[i]); });
+	suite.run("float3.add", "", n, [&] { for (int i=0; i<n; i++) out3[i]=a3[i]+b3[i]; });
+	suite.run("float3.mulScalar", "", n, [&] { for (int i=0; i<n; i++) out3[i]=a3[i]*1.5f; });
+	suite.run("float3.dot", "", n, [&] { for (int i=0; i<n; i++) outF[i]=dot(a3[i], b3[i]); });
+	suite.run("float3.cross", "", n, [&] { for (int i=0; i<n; i++) out3[i]=cross(a3[i], b3[i]); });
+	suite.run("float3.length", "", n, [&] { for (int i=0; i<n; i++) outF[i]=length(a3[i]); });
+	suite.run("float3.normalize", "", n, [&] { for (int i=0; i<n; i++) out3[i]=normalize(a3[i]); });
+}
+
+//Raster primitives into a buffer that is never shown, ns per call
+void benchRaster(Suite& suite) {
+	printf("\nRaster\n");
+	struct Size {
+		int w, h;
+	};
+	for (Size sz:{Size{200, 150}, Size{480, 270}}) {
+		Raster rst(sz.w, sz.h);
+		rst.setChar('#');
+		suite.run("raster.fillRect", std::to_string(sz.w)+"x"+std::to_string(sz.h), 1, [&] { rst.fillRect(0, 0, sz.w, sz.h); });
+	}
+
+	//everything else from the middle of a screen big enough that nothing clips
+	Raster rst(600, 600);
+	rst.setChar('#');
+	float2 ctr(300, 300);
+	for (int len:{8, 64, 256}) {
+		for (int deg:{0, 30, 45, 90}) {
+			float a=deg*Maths::PI/180;
+			float2 end=ctr+float2(cosf(a), sinf(a))*len;
+			suite.run("raster.drawLine", "len="+std::to_string(len)+" deg="+std::to_string(deg), 1, [&] { rst.drawLine(ctr, end); });
+		}
+	}
+	for (int size:{4, 32, 128}) {
+		float2 b=ctr+float2(size, 0), c=ctr+float2(size/2.f, size);
+		suite.run("raster.fillTriangle", "size="+std::to_string(size), 1, [&] { rst.fillTriangle(ctr, b, c); });
+	}
+	for (int rad:{2, 16, 64}) {
+		suite.run("raster.fillCircle", "r="+std::to_string(rad), 1, [&] { rst.fillCircle(ctr, rad); });
+	}
+	for (int len:{8, 64}) {
+		std::string str(len, 'a');
+		suite.run("raster.drawString", "len="+std::to_string(len), 1, [&] { rst.drawString(0, 300, str); });
+	}
+}
+
+int main(int argc, char** argv) {
+	Suite suite;
+	const char* jsonPath=nullptr;
+	for (int i=1; i<argc; i++) {
+		std::string arg=argv[i];
+		if (arg=="--json"&&i+1<argc) jsonPath=argv[++i];
+		else if (arg=="--filter"&&i+1<argc) suite.filter=argv[++i];
+		else if (arg=="--quick") suite.quick=true;
+		else {
+			printf("usage: displibBench [--filter section] [--json path] [--quick]\n");
+			printf("sections: springs, vector, raster, fast, spatialHash, bvh, quadTree, aabb\n");
+			return 1;
+		}
+	}
+
+	if (suite.wants("springs")) benchSprings(suite);
+	if (suite.wants("vector")) benchVector(suite);
+	if (suite.wants("raster")) benchRaster(suite);
+	if (suite.wants("fast")) benchFast(suite);
+	if (suite.wants("spatialHash")) benchSpatialHash(suite);
+	if (suite.wants("bvh")) benchBVH(suite);
+	if (suite.wants("quadTree")) benchQuadTree(suite);
+	if (suite.wants("aabb")) benchAABB(suite);
+
+	if (jsonPath&&!suite.writeJSON(jsonPath)) {
+		printf("couldnt write %s\n", jsonPath);
+		return 1;
+	}
+	return 0;
+}
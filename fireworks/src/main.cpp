@@ -3,6 +3,7 @@
 
 #include "Engine.h"
 #include "maths/Maths.h"
+#include "maths/Random.h"
 using namespace displib;
 
 struct Particle {
@@ -52,7 +53,10 @@ struct Firework {
 	std::vector<Particle> particles;
 	bool blown=false;
 
-	Firework(float2 pos_, float2 vel_, short col_, int numPtc_, float maxRad_, float minLifeSpan_, float maxLifeSpan_) {
+	//own stream, so the burst is the same whichever thread blows it up
+	Random rng;
+
+	Firework(float2 pos_, float2 vel_, short col_, int numPtc_, float maxRad_, float minLifeSpan_, float maxLifeSpan_, uint64_t seed) : rng(seed) {
 		pos=pos_;
 		vel=vel_;
 		col=col_;
@@ -104,9 +108,9 @@ struct Firework {
 		if (!blown) {
 			for (int i=0; i<numPtc; i++) {
 				//pointing in a random dir, random force, random final age
-				float angle=Maths::random(-Maths::PI, Maths::PI);
-				float rad=Maths::random(maxRad);
-				float lifeSpan=Maths::random(minLifeSpan, maxLifeSpan);
+				float angle=rng.nextFloat(-Maths::PI, Maths::PI);
+				float rad=rng.nextFloat(0, maxRad);
+				float lifeSpan=rng.nextFloat(minLifeSpan, maxLifeSpan);
 				particles.push_back(Particle(pos, float2(cosf(angle), sinf(angle))*rad, lifeSpan));
 			}
 
@@ -132,15 +136,23 @@ class Demo : public Engine {
 	float timer=0;
 	float nextFWTime;
 
+	//tasks run on any worker, so launches draw from here, not the thread's stream
+	Random rng;
+
 	void setup() override {
+		rng.setSeed(Random::local().next());
 		grav=float2(0, 9.8f);
-		nextFWTime=Maths::random(0.4f, 1.1f);
+		nextFWTime=rng.nextFloat(0.4f, 1.1f);
+
+		//new ones join the list once the old ones are done with it
+		addTask("fireworks", [this](float dt) { updateFireworks(dt); });
+		addTask("launch", [this](float dt) { launch(dt); }, {"fireworks"});
 	}
 
-	void update(float dt) override {
-		//update all fireworks
-		for (int i=fireworks.size()-1; i>=0; i--) {
-			Firework& f=fireworks.at(i);
+	void updateFireworks(float dt) {
+		//each firework and its particles are on their own
+		tasks.parallelFor(fireworks.size(), [&](int i) {
+			Firework& f=fireworks[i];
 
 			//shoot out particles!
 			if (f.isAtApex()) {
@@ -149,27 +161,31 @@ class Demo : public Engine {
 
 			f.applyForce(grav);
 			f.update(dt);
+		});
 
-			//"dynamically" clear fireworks
-			if (f.isDead()) {
+		//"dynamically" clear fireworks
+		for (int i=fireworks.size()-1; i>=0; i--) {
+			if (fireworks[i].isDead()) {
 				fireworks.erase(fireworks.begin()+i);
 			}
 		}
+	}
 
+	void launch(float dt) {
 		//every so often
 		if (timer>nextFWTime) {
 			//reset timer
 			timer=0;
 
 			//choose random amount of time to spawn next one
-			nextFWTime=Maths::random(0.4f, 1.1f);
-
-			float x=Maths::random(width*0.1f, width*0.9f);
-			float xv=Maths::random(-6, 6);
-			float yv=-Maths::random(18, 42);
-			int num=Maths::random(120, 350);
-			short col=Maths::random(16);
-			fireworks.push_back(Firework(float2(x, height), float2(xv, yv), col, num, width/12, 1.3f, 2.7f));
+			nextFWTime=rng.nextFloat(0.4f, 1.1f);
+
+			float x=rng.nextFloat(width*0.1f, width*0.9f);
+			float xv=rng.nextFloat(-6, 6);
+			float yv=-rng.nextFloat(18, 42);
+			int num=rng.nextFloat(120, 350);
+			short col=rng.nextInt(16);
+			fireworks.push_back(Firework(float2(x, height), float2(xv, yv), col, num, width/12, 1.3f, 2.7f, rng.next()));
 		}
 
 		//always update timer
@@ -200,7 +216,7 @@ class Demo : public Engine {
 };
 
 int main() {
-	srand(time(NULL));
+	Random::seed(time(NULL));
 
 	//init custom graphics engine
 	Demo d=Demo();
@@ -1,5 +1,6 @@
 #include "Engine.h"
 #include "maths/Maths.h"
+#include "io/Snapshot.h"
 using namespace displib;
 
 class Demo : public Engine {
@@ -37,9 +38,14 @@ class Demo : public Engine {
 	};
 	int typeRender=1;
 
+	Metrics::Id itersId=Metrics::counter("solver iterations", "gauss-seidel sweeps over the grid");
+
 	float mouseTimer=0;
 	float2 mousePos, oldMousePos;
 
+	bool save=false, wasSave=false;
+	bool load=false, wasLoad=false;
+
 	int IX(int i, int j) {
 		return i+j*(width+2);
 	}
@@ -62,6 +68,7 @@ class Demo : public Engine {
 	void diffuse(int b, float* x, float* x0, float diff, float dt) {
 		//make each cell more similar to its neighbor
 		float a=dt*diff*width*height;
+		Metrics::add(itersId, iter);
 		for (int k=0; k<iter; k++) {
 			for (int i=1; i<=width; i++) {
 				for (int j=1; j<=height; j++) {
@@ -137,6 +144,7 @@ class Demo : public Engine {
 		}
 		setBound(0, div); setBound(0, p);
 
+		Metrics::add(itersId, iter);
 		for (k=0; k<iter; k++) {
 			for (i=1; i<=width; i++) {
 				for (j=1; j<=height; j++) {
@@ -195,7 +203,39 @@ class Demo : public Engine {
 		x[IX(width+1, height+1)]=0.5f*(x[IX(width, height+1)]+x[IX(width+1, height)]);
 	}
 
+	void saveSnapshot() {
+		SnapshotWriter out("fluidSim.snap");
+		out.put("u", u, size);
+		out.put("v", v, size);
+		out.put("dens", dens, size);
+		out.put("uP", uPrev, size);
+		out.put("vP", vPrev, size);
+		out.put("dP", densPrev, size);
+		out.close();
+	}
+
+	void loadSnapshot() {
+		SnapshotReader in("fluidSim.snap");
+		const char* tags[6]{"u", "v", "dens", "uP", "vP", "dP"};
+		float* dsts[6]{u, v, dens, uPrev, vPrev, densPrev};
+
+		//all or nothing, so a snapshot from another size cant half load
+		const float* srcs[6];
+		for (int i=0; i<6; i++) {
+			srcs[i]=in.view<float>(tags[i], size);
+			if (!srcs[i]) return;
+		}
+		for (int i=0; i<6; i++) memcpy(dsts[i], srcs[i], sizeof(float)*size);
+	}
+
 	void update(float dt) override {
+		//snapshot to file and back
+		save=getKey(VK_F5);
+		if (save&&!wasSave) saveSnapshot();
+		wasSave=save;
+		load=getKey(VK_F9);
+		if (load&&!wasLoad) loadSnapshot();
+		wasLoad=load;
 
 		//mousetry
 		if (mouseTimer>0.075f) {
@@ -1,7 +1,8 @@
 #include "Engine.h"
 #include "maths/Maths.h"
+#include "maths/Random.h"
 #include "maths/vector/float2.h"
-#include "geom/AABB2D.h"
+#include "geom/AABBArray.h"
 #include <vector>
 #include <time.h>
 using namespace displib;
@@ -45,6 +46,9 @@ class Demo : public Engine {
 	bool addingCircles=true;
 	std::vector<circle> circles;
 
+	//one box per circle, tested 8 at a time
+	AABB2DArray boxes;
+
 	void update(float dt) override {
 		if (addingCircles&&timer>0.2f) {//try to add circle this often
 			timer=0.0f;
@@ -57,12 +61,9 @@ class Demo : public Engine {
 				);
 
 				bool inside=false;
-				for (auto& c:circles) {//check all so we dont
-					if (c.containsPt(pt)) {//add a circle in another circle
-						inside=true;
-						break;//opt
-					}
-				}
+				boxes.queryAABB(AABB2D(pt, pt), [&](int i) {//check all so we dont
+					if (circles[i].containsPt(pt)) inside=true;//add a circle in another circle
+				});
 				if (inside)tries++;
 				else {
 					circles.push_back({pt, 0.0f});
@@ -77,19 +78,19 @@ class Demo : public Engine {
 		}
 
 
-		//check all against all
-		for (int i=0; i<circles.size(); i++) {
-			for (int j=i+1; j<circles.size(); j++) {
-				//make sure to be a ref.
-				circle& a=circles.at(i);
-				circle& b=circles.at(j);
-				if (a.overlapCircle(b)) {
-					//stop both
-					a.growing=false;
-					b.growing=false;
-				}
+		//check all against all, boxes first
+		boxes.resize(circles.size());
+		for (int i=0; i<circles.size(); i++) boxes.setCircle(i, circles[i].pos, circles[i].rad);
+		boxes.forEachPair([&](int i, int j) {
+			//make sure to be a ref.
+			circle& a=circles.at(i);
+			circle& b=circles.at(j);
+			if (a.overlapCircle(b)) {
+				//stop both
+				a.growing=false;
+				b.growing=false;
 			}
-		}
+		});
 
 		for (auto& c:circles) {
 			//grow if we can
@@ -120,7 +121,7 @@ class Demo : public Engine {
 };
 
 int main() {
-	srand(time(NULL));
+	Random::seed(time(NULL));
 
 	Demo d;
 	d.startFullscreen(8);
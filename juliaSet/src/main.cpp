@@ -135,6 +135,8 @@ class Demo : public Engine {
 int main() {
 	//init custom graphics engine
 	Demo d;
+	//twice the vertical detail for the same chars
+	d.halfBlocks=true;
 	d.startWindowed(4, 240, 190);
 
 	return 0;
@@ -3,6 +3,7 @@
 
 #include "Engine.h"
 #include "maths/Maths.h"
+#include "maths/Random.h"
 using namespace displib;
 
 struct Ray {
@@ -77,14 +78,15 @@ class Demo : public Engine {
 	}
 
 	void draw(Raster& rst) override {
-		//background
-		rst.setChar(' ');
-		rst.fillRect(0, 0, width, height);
+		//background and all "mirrors", they never move
+		rst.drawLayer(0, [&](Raster& lyr) {
+			lyr.setChar(' ');
+			lyr.fillRect(0, 0, width, height);
 
-		//draw all "mirrors"
-		rst.setChar('m');
-		rst.setColor(Raster::RED);
-		for (Mirror& m:mirrors) m.render(rst);
+			lyr.setChar('m');
+			lyr.setColor(Raster::RED);
+			for (Mirror& m:mirrors) m.render(lyr);
+		});
 
 		//start by making a ray from the mouse pos in a desired direction
 		float2 rayStart(mouseX, mouseY);
@@ -143,7 +145,7 @@ class Demo : public Engine {
 };
 
 int main() {
-	srand(time(NULL));
+	Random::seed(time(NULL));
 
 	//init custom graphics engine
 	Demo d=Demo();
@@ -4,6 +4,7 @@
 #include "Engine.h"
 #include "maths/Maths.h"
 #include "geom/AABB3D.h"
+#include "geom/Camera3D.h"
 using namespace displib;
 
 const int* triTable=new int[4096]{
@@ -265,13 +266,6 @@ const int* triTable=new int[4096]{
 	-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
 };
 
-float2 projfloat3(float3 v, float yaw, float pitch, float zoom) {
-	return float2(
-		sinf(yaw)*v.x-cosf(yaw)*v.z,
-		(cosf(yaw)*v.x+sinf(yaw)*v.z)*cosf(pitch)+sinf(pitch)*v.y
-	)*zoom;
-}
-
 float3 lerpVec(float3 a, float3 b, float t) {
 	return a+(b-a)*t;
 }
@@ -280,16 +274,11 @@ float whatPct(float p, float a, float b) {
 	return (p-a)/(b-a);
 }
 
-struct tri {
-	float3 a, b, c;
-
-	float3 getNorm() {
-		return normalize(cross(b-a, c-a));
-	}
-
-	float3 getAvgPos() {
-		return (a+b+c)/3;
-	}
+//cube edge to grid edge, as corner offset and axis(0 x, 1 y, 2 z)
+const int edgeTable[12][4]={
+	{0, 0, 0, 0}, {1, 0, 0, 2}, {0, 0, 1, 0}, {0, 0, 0, 2},
+	{0, 1, 0, 0}, {1, 1, 0, 2}, {0, 1, 1, 0}, {0, 1, 0, 2},
+	{0, 0, 0, 1}, {1, 0, 0, 1}, {1, 0, 1, 1}, {0, 0, 1, 1}
 };
 
 struct metaball {
@@ -327,6 +316,12 @@ class Demo : public Engine {
 
 	float camYaw=-0.983478f, camPitch=-1.922638f;
 	float camZoom;
+	//bounds corners as last drawn to the background layer, in cells
+	int lastCorners[16]={};
+	Camera3D cam;
+
+	Metrics::Id trisId=Metrics::counter("triangles", "triangles emitted by marching");
+	Metrics::Id drawnId=Metrics::counter("triangles drawn", "front facing triangles filled");
 
 	const char* asciiArr=" .,~=#&@";
 
@@ -369,6 +364,7 @@ class Demo : public Engine {
 		bounds=AABB3D(-1, -1, -1, 1, 1, 1);
 
 		ctr=float2(width/2, height/2);
+		cam.pool=&tasks;
 
 		lightPos=float3(60, 40, 90);
 
@@ -436,40 +432,65 @@ class Demo : public Engine {
 	}
 
 	void draw(Raster& rst) override {
-		//draw background
-		rst.setChar(' ');
-		rst.fillRect(0, 0, width, height);
+		cam.setOrbit(camYaw, camPitch, 120, camZoom, ctr);
+
+		//bounds corners, bit 2 picks max x, bit 1 max y, bit 0 max z
+		float2 crn[8];
+		for (int c=0; c<8; c++) {
+			crn[c]=cam.project(float3(
+				c&4?bounds.max.x:bounds.min.x,
+				c&2?bounds.max.y:bounds.min.y,
+				c&1?bounds.max.z:bounds.min.z
+			));
+		}
 
-		//draw bounds
-		rst.setChar(0x2588);
-		float nx=bounds.min.x, ny=bounds.min.y, nz=bounds.min.z;
-		float xx=bounds.max.x, xy=bounds.max.y, xz=bounds.max.z;
-		float2 nnn=projfloat3(float3(nx, ny, nz), camYaw, camPitch, camZoom)+ctr;
-		float2 nnx=projfloat3(float3(nx, ny, xz), camYaw, camPitch, camZoom)+ctr;
-		float2 nxn=projfloat3(float3(nx, xy, nz), camYaw, camPitch, camZoom)+ctr;
-		float2 nxx=projfloat3(float3(nx, xy, xz), camYaw, camPitch, camZoom)+ctr;
-		float2 xnn=projfloat3(float3(xx, ny, nz), camYaw, camPitch, camZoom)+ctr;
-		float2 xnx=projfloat3(float3(xx, ny, xz), camYaw, camPitch, camZoom)+ctr;
-		float2 xxn=projfloat3(float3(xx, xy, nz), camYaw, camPitch, camZoom)+ctr;
-		float2 xxx=projfloat3(float3(xx, xy, xz), camYaw, camPitch, camZoom)+ctr;
-		//top
-		rst.drawLine(nnn, nnx);
-		rst.drawLine(nnx, xnx);
-		rst.drawLine(xnx, xnn);
-		rst.drawLine(xnn, nnn);
-		//verts
-		rst.drawLine(nnn, nxn);
-		rst.drawLine(nnx, nxx);
-		rst.drawLine(xnx, xxx);
-		rst.drawLine(xnn, xxn);
-		//bottom
-		rst.drawLine(nxn, nxx);
-		rst.drawLine(nxx, xxx);
-		rst.drawLine(xxx, xxn);
-		rst.drawLine(xxn, nxn);
-
-		//marching cubes
-		std::vector<tri> tris;
+		//background and bounds only change once a corner moves to another cell
+		bool moved=false;
+		for (int c=0; c<8; c++) {
+			int cx=round(crn[c].x), cy=round(crn[c].y);
+			moved|=cx!=lastCorners[c*2]||cy!=lastCorners[c*2+1];
+			lastCorners[c*2]=cx, lastCorners[c*2+1]=cy;
+		}
+		if (moved) rst.invalidateLayer(0);
+		rst.drawLayer(0, [&](Raster& lyr) {
+			//draw background
+			lyr.setChar(' ');
+			lyr.fillRect(0, 0, width, height);
+
+			//draw bounds
+			lyr.setChar(0x2588);
+			//top
+			lyr.drawLine(crn[0], crn[1]);
+			lyr.drawLine(crn[1], crn[5]);
+			lyr.drawLine(crn[5], crn[4]);
+			lyr.drawLine(crn[4], crn[0]);
+			//verts
+			lyr.drawLine(crn[0], crn[2]);
+			lyr.drawLine(crn[1], crn[3]);
+			lyr.drawLine(crn[5], crn[7]);
+			lyr.drawLine(crn[4], crn[6]);
+			//bottom
+			lyr.drawLine(crn[2], crn[3]);
+			lyr.drawLine(crn[3], crn[7]);
+			lyr.drawLine(crn[7], crn[6]);
+			lyr.drawLine(crn[6], crn[2]);
+		});
+
+		//marching cubes, each grid edge makes at most one vertex
+		//shared by all the cubes round it, id is grid point*3+axis
+		std::vector<int> edgeVtx(size*size*size*3, -1);
+		std::vector<float3> vtxs;
+		std::vector<int> ids;
+		auto edgeVertex=[&](int i, int j, int k, int axis) {
+			int e=ix(i, j, k)*3+axis;
+			if (edgeVtx[e]==-1) {
+				int i2=i+(axis==0), j2=j+(axis==1), k2=k+(axis==2);
+				float va=valField[ix(i, j, k)], vb=valField[ix(i2, j2, k2)];
+				edgeVtx[e]=vtxs.size();
+				vtxs.push_back(lerpVec(posField[ix(i, j, k)], posField[ix(i2, j2, k2)], whatPct(threshold, va, vb)));
+			}
+			return edgeVtx[e];
+		};
 		for (int i=0; i<size-1; i++) {
 			for (int j=0; j<size-1; j++) {
 				for (int k=0; k<size-1; k++) {
@@ -482,15 +503,6 @@ class Demo : public Engine {
 					float v5=valField[ix(i+1, j+1, k)];
 					float v6=valField[ix(i+1, j+1, k+1)];
 					float v7=valField[ix(i, j+1, k+1)];
-					//get cube poses
-					float3 p0=posField[ix(i, j, k)];
-					float3 p1=posField[ix(i+1, j, k)];
-					float3 p2=posField[ix(i+1, j, k+1)];
-					float3 p3=posField[ix(i, j, k+1)];
-					float3 p4=posField[ix(i, j+1, k)];
-					float3 p5=posField[ix(i+1, j+1, k)];
-					float3 p6=posField[ix(i+1, j+1, k+1)];
-					float3 p7=posField[ix(i, j+1, k+1)];
 					//get cube "state"
 					int tti=(
 						(v7>threshold)*128+
@@ -503,50 +515,43 @@ class Demo : public Engine {
 						(v0>threshold)
 						)*16;
 					//loop through tri table to get correct tris.
-					for (int l=tti; l<tti+15&&triTable[l]!=-1; l+=3) {
-						float3 p[3];
-						for (int m=0; m<3; m++) {
-							switch (triTable[l+m]) {
-								case 0: p[m]=lerpVec(p0, p1, whatPct(threshold, v0, v1)); break;
-								case 1: p[m]=lerpVec(p1, p2, whatPct(threshold, v1, v2)); break;
-								case 2: p[m]=lerpVec(p2, p3, whatPct(threshold, v2, v3)); break;
-								case 3: p[m]=lerpVec(p3, p0, whatPct(threshold, v3, v0)); break;
-								case 4: p[m]=lerpVec(p4, p5, whatPct(threshold, v4, v5)); break;
-								case 5: p[m]=lerpVec(p5, p6, whatPct(threshold, v5, v6)); break;
-								case 6: p[m]=lerpVec(p6, p7, whatPct(threshold, v6, v7)); break;
-								case 7: p[m]=lerpVec(p7, p4, whatPct(threshold, v7, v4)); break;
-								case 8: p[m]=lerpVec(p0, p4, whatPct(threshold, v0, v4)); break;
-								case 9: p[m]=lerpVec(p1, p5, whatPct(threshold, v1, v5)); break;
-								case 10: p[m]=lerpVec(p2, p6, whatPct(threshold, v2, v6)); break;
-								case 11: p[m]=lerpVec(p3, p7, whatPct(threshold, v3, v7)); break;
-							}
-						}
-						//add tri to list
-						tris.push_back({p[0], p[1], p[2]});
+					for (int l=tti; l<tti+15&&triTable[l]!=-1; l++) {
+						const int* e=edgeTable[triTable[l]];
+						ids.push_back(edgeVertex(i+e[0], j+e[1], k+e[2], e[3]));
 					}
 				}
 			}
 		}
 
+		//project every vertex once
+		int vtxNum=vtxs.size();
+		std::vector<float2> projected(vtxNum);
+		std::vector<float> depths(vtxNum);
+		cam.projectBatch(vtxs.data(), projected.data(), depths.data(), vtxNum);
+
 		//"optimization" show only front facing tris
-		std::vector<tri> trisToDraw;
-		for (tri& t:tris) {
-			//culling
-			if (dot(t.getNorm(), t.a-camPos)<0) {
+		std::vector<int> trisToDraw;
+		for (int t=0; t<(int)ids.size(); t+=3) {
+			//culling by screen winding
+			if (Camera3D::isFrontFacing(projected[ids[t]], projected[ids[t+1]], projected[ids[t+2]])) {
 				trisToDraw.push_back(t);
 			}
 		}
 
 		//"painters"-ish algo to sort by what is closer to the "camera"
-		sort(trisToDraw.begin(), trisToDraw.end(), [&](tri& a, tri& b) {
-			return length(a.getAvgPos()-camPos)>length(b.getAvgPos()-camPos);
+		sort(trisToDraw.begin(), trisToDraw.end(), [&](int a, int b) {
+			return depths[ids[a]]+depths[ids[a+1]]+depths[ids[a+2]]>depths[ids[b]]+depths[ids[b+1]]+depths[ids[b+2]];
 		});
 
+		Metrics::add(trisId, ids.size()/3);
+		Metrics::add(drawnId, trisToDraw.size());
+
 		//"project" tris
 		rst.setChar(0x2588);
-		for (tri& t:trisToDraw) {
-			float3 tPos=t.getAvgPos();
-			float3 tNorm=t.getNorm();
+		for (int t:trisToDraw) {
+			float3 ta=vtxs[ids[t]], tb=vtxs[ids[t+1]], tc=vtxs[ids[t+2]];
+			float3 tPos=(ta+tb+tc)/3;
+			float3 tNorm=normalize(cross(tb-ta, tc-ta));
 			//diffuse is norm vs lightdir, "direct lighting"
 			float3 dirToLight=normalize(lightPos-tPos);
 			float diffuseShade=dot(tNorm, dirToLight);
@@ -556,9 +561,9 @@ class Demo : public Engine {
 			rst.setChar(asciiArr[asi]);
 
 			//get projected coords
-			float2 a=projfloat3(t.a, camYaw, camPitch, camZoom)+ctr;
-			float2 b=projfloat3(t.b, camYaw, camPitch, camZoom)+ctr;
-			float2 c=projfloat3(t.c, camYaw, camPitch, camZoom)+ctr;
+			float2 a=projected[ids[t]];
+			float2 b=projected[ids[t+1]];
+			float2 c=projected[ids[t+2]];
 			rst.fillTriangle(a, b, c);
 
 			//show wireframe
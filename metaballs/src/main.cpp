@@ -2,6 +2,8 @@
 
 #include "Engine.h"
 #include "maths/Maths.h"
+#include "maths/Random.h"
+#include "maths/vector/float2x8.h"
 #include "geom/AABB2D.h"
 using namespace displib;
 
@@ -74,24 +76,33 @@ class Demo : public Engine {
 		//metaball method
 		rst.setChar('#');
 		bool* grid=new bool[width*height];
-		for (int x=0; x<width; x++) {
-			for (int y=0; y<height; y++) {
+		float amt=Maths::map(sinf(totalDeltaTime), -1, 1, 0.3f, 5.5f);
+		for (int y=0; y<height; y++) {
+			//8 pixels along the row at once
+			for (int x=0; x<width; x+=8) {
+				float2x8 pt(floatx8::ramp(x), floatx8(y));
+
 				//sum all "radius strengths"
-				float sum=0;
+				floatx8 sum;
 				for (int i=0; i<num; i++) {
-					float2 sb=float2(x, y)-metaballs[i].pos;
+					float2x8 sb=pt-float2x8(metaballs[i].pos);
 					float r=metaballs[i].rad;
-					sum+=r*r/dot(sb, sb);
+					sum+=floatx8(r*r)/dot(sb, sb);
+				}
+				float sums[8];
+				sum.store(sums);
+
+				int n=width-x<8?width-x:8;
+				for (int k=0; k<n; k++) {
+					//make 0-1 float into ascii ramp value
+					float pct=Maths::clamp(sums[k]/8, 0, 1);
+					int asi=Maths::clamp(pct*colorLen, 0, colorLen-1);
+					rst.setColor(colorArr[asi]);
+					rst.putPixel(x+k, y);
+
+					//put val into grid for edge detect.
+					grid[ix(x+k, y)]=sums[k]>amt;
 				}
-				//make 0-1 float into ascii ramp value
-				float pct=Maths::clamp(sum/8, 0, 1);
-				int asi=Maths::clamp(pct*colorLen, 0, colorLen-1);
-				rst.setColor(colorArr[asi]);
-				rst.putPixel(x, y);
-
-				//put val into grid for edge detect.
-				float amt=Maths::map(sinf(totalDeltaTime), -1, 1, 0.3f, 5.5f);
-				grid[ix(x, y)]=sum>amt;
 			}
 		}
 
@@ -123,7 +134,7 @@ class Demo : public Engine {
 };
 
 int main() {
-	srand(time(NULL));
+	Random::seed(time(NULL));
 
 	//init custom graphics engine
 	Demo d=Demo();
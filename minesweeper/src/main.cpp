@@ -3,6 +3,8 @@
 
 #include "Engine.h"
 #include "maths/Maths.h"
+#include "maths/Random.h"
+#include "io/Sprite.h"
 using namespace displib;
 
 struct Cell {
@@ -59,6 +61,9 @@ class Demo : public Engine {
 		Raster::GREY,
 		Raster::WHITE
 	};
+	//baked tiles, revealed ones indexed by checker and number
+	Sprite revealedTiles[18];
+	Sprite hiddenTile, flaggedTile;
 
 	void setup() override {
 		//plenty of tiles
@@ -66,6 +71,42 @@ class Demo : public Engine {
 		cols=width/res;
 		rows=height/res;
 		cellGrid=new Cell[cols*rows];
+
+		//bake every tile look once
+		for (int c=0; c<2; c++) {
+			for (int n=0; n<9; n++) {
+				revealedTiles[c*9+n]=Sprite::bake(res, res, [&](Raster& rst) {
+					rst.setChar(0x2588);
+					//switch between colors
+					rst.setColor(c?Raster::DARK_GREY:Raster::WHITE);
+					rst.fillRect(0, 0, res, res);
+
+					if (n>0) {
+						//show number
+						rst.setChar('0'+n);
+						//in the appropriate coloring
+						rst.setColor(colors[n-1]);
+						//as char in center of cell
+						rst.putPixel(res/2, res/2);
+					}
+				});
+			}
+		}
+		hiddenTile=Sprite::bake(res, res, [&](Raster& rst) {
+			//this is a mine"field" so make it green
+			rst.setChar(0x2588);
+			rst.setColor(Raster::GREEN);
+			rst.fillRect(0, 0, res, res);
+		});
+		flaggedTile=Sprite::bake(res, res, [&](Raster& rst) {
+			rst.setChar(0x2588);
+			rst.setColor(Raster::GREEN);
+			rst.fillRect(0, 0, res, res);
+			//draw "flag"
+			rst.setChar('!');
+			rst.setColor(Raster::RED);
+			rst.fillRect(1, 1, res-2, res-2);
+		});
 	}
 
 	int cellGridInit(int i, int j) {
@@ -188,35 +229,11 @@ class Demo : public Engine {
 				float y=j*res;
 				Cell& cell=cellGrid[i+j*cols];
 				if (cell.revealed) {
-					rst.setChar(0x2588);
 					//index checker method
 					bool checker=(i%2)==(j%2);
-					//switch between colors
-					rst.setColor(checker?Raster::DARK_GREY:Raster::WHITE);
-					rst.fillRect(x, y, res, res);
-
-					if (cell.numBombs>0) {
-						//show number
-						rst.setChar('0'+cell.numBombs);
-						//in the appropriate coloring
-						rst.setColor(colors[cell.numBombs-1]);
-						//as char in center of cell
-						rst.putPixel(x+res/2, y+res/2);
-					}
-				}
-				else {
-					//this is a mine"field" so make it green
-					rst.setChar(0x2588);
-					rst.setColor(Raster::GREEN);
-					rst.fillRect(x, y, res, res);
-					if (cell.flagged) {
-						//draw "flag"
-						rst.setChar('!');
-						rst.setColor(Raster::RED);
-						//as char in center of cell
-						rst.fillRect(x+1, y+1, res-2, res-2);
-					}
+					rst.blit(revealedTiles[checker*9+cell.numBombs], x, y);
 				}
+				else rst.blit(cell.flagged?flaggedTile:hiddenTile, x, y);
 
 				//highlight cell if mouse inside
 				if (i==mouseI&&j==mouseJ) {
@@ -236,7 +253,7 @@ class Demo : public Engine {
 };
 
 int main() {
-	srand(time(NULL));
+	Random::seed(time(NULL));
 
 	//init custom graphics engine
 	Demo d=Demo();
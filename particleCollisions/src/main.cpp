@@ -3,7 +3,9 @@
 
 #include "Engine.h"
 #include <geom/AABB2D.h>
+#include "geom/SpatialHash2D.h"
 #include "maths/Maths.h"
+#include "maths/Random.h"
 using namespace displib;
 
 struct ptc {
@@ -106,6 +108,8 @@ class Demo : public Engine {
 	public:
 	float2 grav;
 	std::vector<ptc> ptcs;
+	std::vector<float2> ptcPos;
+	SpatialHash2D grid=SpatialHash2D(6);
 	std::vector<barrier> barriers;
 	std::vector<std::pair<float2, float2>> connections;
 	float timer=0;
@@ -119,6 +123,9 @@ class Demo : public Engine {
 
 	bool showConnections=false;
 
+	Metrics::Id contactsId=Metrics::counter("contacts", "particle pairs touching");
+	Metrics::Id barrierHitsId=Metrics::counter("barrier hits", "particles touching a barrier");
+
 	const char* asciiArr=" .,~=#&@";
 	short* colorArr=new short[8]{
 		Raster::DARK_BLUE,
@@ -169,27 +176,34 @@ class Demo : public Engine {
 		//actually change the pos
 		if (heldVec!=nullptr) *heldVec=mousePos;
 
+		//only nearby pairs, biggest radius is 3 so nothing further than 6 can touch
+		ptcPos.resize(ptcs.size());
+		for (int i=0; i<ptcs.size(); i++) ptcPos[i]=ptcs[i].pos;
+		grid.rebuild(ptcPos.data(), ptcPos.size());
+		int contacts=0;
+		grid.forEachPair(6, [&](int i, int j) {
+			ptc& a=ptcs[i];
+			ptc& b=ptcs[j];
+			float totalRad=a.rad+b.rad;
+			float dist=length(a.pos-b.pos);
+			//if particles touch [circle overlap]
+			if (dist<totalRad) {
+				contacts++;
+				if (showConnections) connections.push_back({a.pos, b.pos});
+
+				//make new temp spring
+				spr s(a, b, stiff, damp);
+				s.restLen=a.rad+b.rad;
+				s.update();
+			}
+		});
+
+		Metrics::add(contactsId, contacts);
+
 		//for each particle
+		int barrierHits=0;
 		for (int i=0; i<ptcs.size(); i++) {
 			ptc& a=ptcs.at(i);
-			//check all of OTHER the particles AFTER it
-			for (int j=i+1; j<ptcs.size(); j++) {
-				ptc& b=ptcs.at(j);
-				//if touching optimization [aabb overlap]
-				if (a.getAABB().overlapAABB(b.getAABB())) {
-					float totalRad=a.rad+b.rad;
-					float dist=length(a.pos-b.pos);
-					//if particles touch [circle overlap]
-					if (dist<totalRad) {
-						if (showConnections) connections.push_back({a.pos, b.pos});
-
-						//make new temp spring
-						spr s(a, b, stiff, damp);
-						s.restLen=a.rad+b.rad;
-						s.update();
-					}
-				}
-			}
 
 			//check all barriers
 			for (barrier& b:barriers) {
@@ -197,6 +211,7 @@ class Demo : public Engine {
 				float t=Maths::clamp(dot(pa, ba)/dot(ba, ba), 0, 1);
 				float2 bPt=b.a+ba*t;
 				if (length(bPt-a.pos)<b.rad+a.rad) {//"inside" barrier
+					barrierHits++;
 					//make temp particle
 					ptc p(bPt, b.rad);
 					//make temp spring
@@ -208,6 +223,8 @@ class Demo : public Engine {
 			}
 		}
 
+		Metrics::add(barrierHitsId, barrierHits);
+
 		//update all particles
 		for (ptc& p:ptcs) {
 			p.applyForce(grav);
@@ -287,9 +304,13 @@ class Demo : public Engine {
 			}
 		}
 
-		rst.setChar(0x2588);
-		rst.setColor(Raster::WHITE);
-		for (barrier& b:barriers) b.render(rst);
+		//barriers only change while being dragged
+		if (heldVec!=nullptr) rst.invalidateLayer(0);
+		rst.drawLayer(0, [&](Raster& lyr) {
+			lyr.setChar(0x2588);
+			lyr.setColor(Raster::WHITE);
+			for (barrier& b:barriers) b.render(lyr);
+		});
 
 		if (showConnections) {
 			rst.setColor(Raster::DARK_GREY);
@@ -301,7 +322,7 @@ class Demo : public Engine {
 };
 
 int main() {
-	srand(time(NULL));
+	Random::seed(time(NULL));
 
 	//init custom graphics engine
 	Demo d;
@@ -4,6 +4,8 @@
 #include "Engine.h"
 #include "geom/AABB2D.h"
 #include "maths/Maths.h"
+#include "maths/Fast.h"
+#include "maths/Random.h"
 using namespace displib;
 
 struct Particle {
@@ -37,10 +39,14 @@ struct Particle {
 
 	AABB2D getAABB() {
 		//sort to find extreme points
+		//corners by turning the first one a side at a time, two sincos total
 		float nx=INFINITY, ny=INFINITY, mx=-INFINITY, my=-INFINITY;
+		float2 dir, step;
+		Maths::fast::sincos(rot, dir.y, dir.x);
+		Maths::fast::sincos(Maths::TAU/sides, step.y, step.x);
 		for (int i=0; i<sides; i++) {
-			float a0=Maths::map(i, 0, sides, 0, Maths::TAU)+rot;
-			float2 v0=float2(cosf(a0), sinf(a0))*rad+pos;
+			float2 v0=dir*rad+pos;
+			dir=float2(dir.x*step.x-dir.y*step.y, dir.x*step.y+dir.y*step.x);
 			nx=min(nx, v0.x);
 			ny=min(ny, v0.y);
 			mx=max(mx, v0.x);
@@ -60,12 +66,20 @@ struct Particle {
 		int asi=Maths::clamp(pct*8, 0, 7);
 		rst.setChar(" .,~=#&@"[asi]);
 		//polar to cartesian madness
+		//each corner once, side i ends where side i+1 starts
+		float2 first, v0;
+		Maths::fast::sincos(rot, first.y, first.x);
+		first=first*rad+pos;
+		v0=first;
 		for (int i=0; i<sides; i++) {
-			float a0=Maths::map(i, 0, sides, 0, Maths::TAU)+rot;
-			float a1=Maths::map((i+1)%sides, 0, sides, 0, Maths::TAU)+rot;
-			float2 v0=float2(cosf(a0), sinf(a0))*rad+pos;
-			float2 v1=float2(cosf(a1), sinf(a1))*rad+pos;
+			float2 v1=first;
+			if (i<sides-1) {
+				float a1=Maths::map(i+1, 0, sides, 0, Maths::TAU)+rot;
+				Maths::fast::sincos(a1, v1.y, v1.x);
+				v1=v1*rad+pos;
+			}
 			rst.drawLine(v0, v1);
+			v0=v1;
 		}
 	}
 };
@@ -146,7 +160,7 @@ class Demo : public Engine {
 };
 
 int main() {
-	srand(time(NULL));
+	Random::seed(time(NULL));
 
 	//init custom graphics engine
 	Demo d=Demo();
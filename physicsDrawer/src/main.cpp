@@ -1,8 +1,10 @@
 #include <list>
 #include <algorithm>
+#include <unordered_map>
 
 #include "Engine.h"
 #include "geom/AABB2D.h"
+#include "io/Snapshot.h"
 using namespace displib;
 
 #define POINT_SIZE 2.49f
@@ -104,6 +106,17 @@ struct spring {
 	}
 };
 
+//sticks and springs by point index instead of pointer, for snapshots.
+struct stickLink {
+	int a, b;
+	float restLen;
+};
+
+struct springLink {
+	int a, b;
+	float restLen, stiff, damp;
+};
+
 class Demo : public Engine {
 	public:
 	float2 grav;
@@ -123,6 +136,8 @@ class Demo : public Engine {
 	point* springConnectStart=nullptr;
 	bool hold=false, wasHold=false;
 	point* heldPoint=nullptr;
+	bool save=false, wasSave=false;
+	bool load=false, wasLoad=false;
 
 	void setup() override {
 		grav=float2(0, 32);
@@ -130,9 +145,80 @@ class Demo : public Engine {
 		bounds=AABB2D(0, 0, width, height);
 	}
 
+	void saveSnapshot() {
+		std::vector<point> pts(points.begin(), points.end());
+		std::unordered_map<const point*, int> index;
+		int i=0;
+		for (const point& p:points) index[&p]=i++;
+
+		std::vector<stickLink> stickLinks;
+		for (const stick& s:sticks) stickLinks.push_back({index[s.a], index[s.b], s.restLen});
+		std::vector<springLink> springLinks;
+		for (const spring& s:springs) springLinks.push_back({index[s.a], index[s.b], s.restLen, s.stiff, s.damp});
+
+		SnapshotWriter out("physicsDrawer.snap");
+		out.put("pts", pts);
+		out.put("stk", stickLinks);
+		out.put("spr", springLinks);
+		out.putValue("run", running);
+		out.close();
+	}
+
+	void loadSnapshot() {
+		SnapshotReader in("physicsDrawer.snap");
+		long long numPts=in.count<point>("pts");
+		long long numStk=in.count<stickLink>("stk");
+		long long numSpr=in.count<springLink>("spr");
+		if (numPts<0||numStk<0||numSpr<0) return;
+		const point* pts=in.view<point>("pts", numPts);
+		const stickLink* stk=in.view<stickLink>("stk", numStk);
+		const springLink* spr=in.view<springLink>("spr", numSpr);
+
+		//dont trust links pointing past the points
+		auto valid=[&](int a, int b) { return a>=0&&b>=0&&a<numPts&&b<numPts; };
+		for (int i=0; i<numStk; i++) if (!valid(stk[i].a, stk[i].b)) return;
+		for (int i=0; i<numSpr; i++) if (!valid(spr[i].a, spr[i].b)) return;
+
+		//anything pointing into the old lists goes
+		stickConnectStart=nullptr;
+		springConnectStart=nullptr;
+		heldPoint=nullptr;
+		points.clear();
+		sticks.clear();
+		springs.clear();
+
+		std::vector<point*> ptrs;
+		ptrs.reserve(numPts);
+		for (int i=0; i<numPts; i++) {
+			points.push_back(pts[i]);
+			ptrs.push_back(&points.back());
+		}
+		for (int i=0; i<numStk; i++) {
+			stick s;
+			s.a=ptrs[stk[i].a], s.b=ptrs[stk[i].b];
+			s.restLen=stk[i].restLen;
+			sticks.push_back(s);
+		}
+		for (int i=0; i<numSpr; i++) {
+			spring s;
+			s.a=ptrs[spr[i].a], s.b=ptrs[spr[i].b];
+			s.restLen=spr[i].restLen, s.stiff=spr[i].stiff, s.damp=spr[i].damp;
+			springs.push_back(s);
+		}
+		in.getValue("run", running);
+	}
+
 	void update(float dt) override {
 		float2 mousePos(mouseX, mouseY);
 
+		//snapshot to file and back
+		save=getKey(VK_F5);
+		if (save&&!wasSave) saveSnapshot();
+		wasSave=save;
+		load=getKey(VK_F9);
+		if (load&&!wasLoad) loadSnapshot();
+		wasLoad=load;
+
 		//for pause/play
 		pausePlay=getKey(VK_SPACE);
 		if (pausePlay&&!wasPausePlay) {
@@ -2,6 +2,7 @@
 
 #include "Engine.h"
 #include "maths/Maths.h"
+#include "maths/Random.h"
 using namespace displib;
 
 class Demo : public Engine {
@@ -81,7 +82,7 @@ class Demo : public Engine {
 		setTitle("Simple Polygon Clipping");
 
 		//some randomly sized poly on the screen
-		mainNum=Maths::clamp(rand()%7+3, 3, 10);
+		mainNum=Maths::clamp(Random::local().nextInt(7)+3, 3, 10);
 		mainPoly=new float2[mainNum];
 		float rad=Maths::random(height/6, height/3);
 		float2 pos(
@@ -153,7 +154,7 @@ class Demo : public Engine {
 };
 
 int main() {
-	srand(time(NULL));
+	Random::seed(time(NULL));
 
 	//init custom graphics engine
 	Demo d=Demo();
@@ -2,6 +2,7 @@
 
 #include "Engine.h"
 #include "maths/Maths.h"
+#include "maths/Random.h"
 using namespace displib;
 
 struct Ray {
@@ -110,12 +111,14 @@ class Demo : public Engine {
 		rst.setColor(Raster::CYAN);
 		rst.putPixel(camPos.x, camPos.y);
 
-		//draw "lines"
-		rst.setChar('#');
-		for (Line& l:lines) {
-			rst.setColor(l.col);
-			l.render(rst);
-		}
+		//draw "lines", they never move
+		rst.drawLayer(0, [&](Raster& lyr) {
+			lyr.setChar('#');
+			for (Line& l:lines) {
+				lyr.setColor(l.col);
+				l.render(lyr);
+			}
+		});
 
 		//show fps
 		rst.setChar(' ');
@@ -126,7 +129,7 @@ class Demo : public Engine {
 };
 
 int main() {
-	srand(time(NULL));
+	Random::seed(time(NULL));
 
 	//init custom graphics engine
 	Demo d=Demo();
@@ -1,12 +1,24 @@
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
 #include <vector>
 
 #include "Engine.h"
+#include "geom/BVH.h"
 #include "maths/Maths.h"
+#include "maths/Fast.h"
 #include "maths/vector/float3.h"
+#include "maths/vector/SoA.h"
 using namespace displib;
 
 #define EPSILON 0.0001f
 
+//obj given on the command line, replaces the tetrahedron
+static std::string SCENE_FILE;
+
 struct Ray {
 	float3 origin, dir;
 
@@ -37,118 +49,397 @@ struct Hit {
 	}
 };
 
-struct Shape {
+struct Material {
 	short col=0x000F;
 	bool reflective=false;
+};
 
-	Shape() {}
+//primitives split by type, one array per field, with what a hit test needs worked out on load.
+//ids count spheres first, then tris. materials are only looked up for the winning hit.
+struct Scene {
+	std::vector<Material> materials;
+
+	//spheres
+	float3Array sphCtrs;
+	std::vector<float> sphRads;
+	std::vector<int> sphMats;
+	BVH sphBVH;
+
+	//tris, as v0 and the two edges from it for moller trumbore
+	float3Array triV0s, triE1s, triE2s, triNorms;
+	std::vector<int> triMats;
+	BVH triBVH;
+
+	int addMaterial(short col, bool reflective) {
+		Material m;
+		m.col=col;
+		m.reflective=reflective;
+		materials.push_back(m);
+		return materials.size()-1;
+	}
 
-	virtual float intersectRay(Ray r) { return 0; }
+	void addSphere(float3 pos, float rad, int mat) {
+		sphCtrs.push_back(pos);
+		sphRads.push_back(rad);
+		sphMats.push_back(mat);
+	}
 
-	virtual bool getIntersection(Ray r, Hit& hitOut) { return false; }
-};
+	void addTri(float3 a, float3 b, float3 c, int mat) {
+		float3 e1=b-a, e2=c-a;
+		triV0s.push_back(a);
+		triE1s.push_back(e1);
+		triE2s.push_back(e2);
+		triNorms.push_back(normalize(cross(e1, e2)));
+		triMats.push_back(mat);
+	}
 
-struct Sphere : Shape {
-	float3 pos;
-	float rad=0;
+	int numSpheres() const { return sphCtrs.size(); }
 
-	Sphere(float3 pos_, float rad_, short col_, bool reflective_) {
-		pos=pos_;
-		rad=rad_;
-		col=col_;
-		reflective=reflective_;
+	int numTris() const { return triV0s.size(); }
+
+	int size() const { return numSpheres()+numTris(); }
+
+	//builds both bvhs and reorders each type to its leaf order, so a leaf is one run of indices.
+	void build() {
+		std::vector<AABB3D> boxes;
+		for (int i=0; i<numSpheres(); i++) {
+			float3 c=sphCtrs.get(i);
+			boxes.push_back(AABB3D(c-sphRads[i], c+sphRads[i]));
+		}
+		sphBVH.build(boxes.data(), boxes.size());
+		float3Array ctrs(numSpheres());
+		std::vector<float> rads(numSpheres());
+		std::vector<int> mats(numSpheres());
+		for (int p=0; p<numSpheres(); p++) {
+			int i=sphBVH.prims[p];
+			ctrs.set(p, sphCtrs.get(i));
+			rads[p]=sphRads[i];
+			mats[p]=sphMats[i];
+			sphBVH.prims[p]=p;
+		}
+		sphCtrs=ctrs; sphRads=rads; sphMats=mats;
+
+		boxes.clear();
+		for (int i=0; i<numTris(); i++) {
+			float3 v0=triV0s.get(i);
+			AABB3D b(v0, v0);
+			b.expand(v0+triE1s.get(i));
+			b.expand(v0+triE2s.get(i));
+			boxes.push_back(b);
+		}
+		triBVH.build(boxes.data(), boxes.size());
+		float3Array v0s(numTris()), e1s(numTris()), e2s(numTris()), norms(numTris());
+		mats.assign(numTris(), 0);
+		for (int p=0; p<numTris(); p++) {
+			int i=triBVH.prims[p];
+			v0s.set(p, triV0s.get(i));
+			e1s.set(p, triE1s.get(i));
+			e2s.set(p, triE2s.get(i));
+			norms.set(p, triNorms.get(i));
+			mats[p]=triMats[i];
+			triBVH.prims[p]=p;
+		}
+		triV0s=v0s; triE1s=e1s; triE2s=e2s; triNorms=norms; triMats=mats;
 	}
 
-	float intersectRay(Ray r) override {
-		float3 oc=r.origin-pos;
+	//closest of spheres start to start+count, if before tBest. no branches, misses just dont win.
+	//shadow rays pass tMin so a sphere cant shadow the point it starts on.
+	void intersectSpheres(const Ray& r, int start, int count, float& tBest, int& idBest, float tMin=0) const {
+		const float* cx=sphCtrs.x(), * cy=sphCtrs.y(), * cz=sphCtrs.z();
 		float a=dot(r.dir, r.dir);
-		float b=2*dot(r.dir, oc);
-		float c=dot(oc, oc)-rad*rad;
-		float disc=b*b-4*a*c;
-		if (disc<EPSILON) return -1;
-		//solve quadratic, + & -
-		float sq=sqrtf(disc);
-		float num=-b-sq;
-		if (num>EPSILON) return num/(2*a);
-		num=-b+sq;
-		if (num>EPSILON) return num/(2*a);
-		return -1;
-	}
-
-	bool getIntersection(Ray r, Hit& hitOut) override {
-		float dist=intersectRay(r);
-		//invalid
-		if (dist<0) return false;
-
-		//use dist to march dir to hitpos
-		float3 hitPos=r.origin+r.dir*dist;
-		//to get norm of UNIFORM surface
-		float3 hitNorm=normalize(hitPos-pos);
-		hitOut=Hit(r, dist, hitPos, hitNorm, col, reflective);
+		for (int i=start; i<start+count; i++) {
+			float ox=r.origin.x-cx[i], oy=r.origin.y-cy[i], oz=r.origin.z-cz[i];
+			float b=2*(r.dir.x*ox+r.dir.y*oy+r.dir.z*oz);
+			float c=ox*ox+oy*oy+oz*oz-sphRads[i]*sphRads[i];
+			float disc=b*b-4*a*c;
+			//solve quadratic, nearer root unless its behind
+			float sq=sqrtf(disc>0?disc:0);
+			float n0=-b-sq, n1=-b+sq;
+			float num=n0>EPSILON?n0:n1;
+			float t=num/(2*a);
+			bool hit=(disc>=EPSILON)&(num>EPSILON)&(t>tMin)&(t<tBest);
+			tBest=hit?t:tBest;
+			idBest=hit?i:idBest;
+		}
+	}
+
+	//same for tris, ids are tri indices here.
+	void intersectTris(const Ray& r, int start, int count, float& tBest, int& idBest) const {
+		const float* v0x=triV0s.x(), * v0y=triV0s.y(), * v0z=triV0s.z();
+		const float* e1x=triE1s.x(), * e1y=triE1s.y(), * e1z=triE1s.z();
+		const float* e2x=triE2s.x(), * e2y=triE2s.y(), * e2z=triE2s.z();
+		float3 d=r.dir;
+		for (int i=start; i<start+count; i++) {
+			//h=cross(d, e2)
+			float hx=d.y*e2z[i]-d.z*e2y[i], hy=d.z*e2x[i]-d.x*e2z[i], hz=d.x*e2y[i]-d.y*e2x[i];
+			float n=e1x[i]*hx+e1y[i]*hy+e1z[i]*hz;
+			float f=1/n;
+			float sx=r.origin.x-v0x[i], sy=r.origin.y-v0y[i], sz=r.origin.z-v0z[i];
+			float u=f*(sx*hx+sy*hy+sz*hz);
+			//q=cross(s, e1)
+			float qx=sy*e1z[i]-sz*e1y[i], qy=sz*e1x[i]-sx*e1z[i], qz=sx*e1y[i]-sy*e1x[i];
+			float v=f*(d.x*qx+d.y*qy+d.z*qz);
+			float t=f*(e2x[i]*qx+e2y[i]*qy+e2z[i]*qz);
+			//parallel rays make nans, which fail every compare
+			bool hit=(fabsf(n)>=EPSILON)&(u>=0)&(u<=1)&(v>=0)&(u+v<=1)&(t>EPSILON)&(t<tBest);
+			tBest=hit?t:tBest;
+			idBest=hit?i:idBest;
+		}
+	}
+
+	//nearest hit distance and id, false if nothing is hit before tMax.
+	bool intersect(const Ray& r, float tMax, float& tOut, int& idOut) const {
+		float t=tMax;
+		int sph=-1, tri=-1;
+		t=sphBVH.traceLeaves(r.origin, r.dir, t, [&](int start, int count, float tMax) {
+			intersectSpheres(r, start, count, tMax, sph);
+			return tMax;
+		});
+		t=triBVH.traceLeaves(r.origin, r.dir, t, [&](int start, int count, float tMax) {
+			intersectTris(r, start, count, tMax, tri);
+			return tMax;
+		});
+
+		//tris started from the sphere distance, so any tri hit is nearer
+		if (tri!=-1) idOut=numSpheres()+tri;
+		else if (sph!=-1) idOut=sph;
+		else return false;
+		tOut=t;
 		return true;
 	}
-};
 
-struct Tri : Shape {
-	float3 v[3];
+	//is anything hit before tMax.
+	bool occluded(const Ray& r, float tMax) const {
+		auto sphLeaf=[&](int start, int count, float tMax) {
+			float t=tMax;
+			int id=-1;
+			intersectSpheres(r, start, count, t, id, EPSILON);
+			return id!=-1;
+		};
+		auto triLeaf=[&](int start, int count, float tMax) {
+			float t=tMax;
+			int id=-1;
+			intersectTris(r, start, count, t, id);
+			return id!=-1;
+		};
+		return sphBVH.occludedLeaves(r.origin, r.dir, tMax, sphLeaf)||triBVH.occludedLeaves(r.origin, r.dir, tMax, triLeaf);
+	}
 
-	Tri(float3 a, float3 b, float3 c, short col_, bool reflective_) {
-		v[0]=a;
-		v[1]=b;
-		v[2]=c;
-		col=col_;
-		reflective=reflective_;
+	//packet versions, lane l is one ray. lanes with tBest at 0 never hit, that is how unused lanes are kept out.
+	//return the lanes that found something nearer, ids of those get the primitive.
+	int intersectSpheres8(const float3x8& o, const float3x8& d, int start, int count, floatx8& tBest, int ids[8], float tMin=0) const {
+		floatx8 a=dot(d, d), eps(EPSILON), lo(tMin);
+		int found=0;
+		for (int i=start; i<start+count; i++) {
+			float3x8 oc=o-float3x8(sphCtrs.get(i));
+			floatx8 b=floatx8(2)*dot(d, oc);
+			floatx8 c=dot(oc, oc)-floatx8(sphRads[i]*sphRads[i]);
+			floatx8 disc=b*b-floatx8(4)*a*c;
+			floatx8 sq=vsqrt(vmax(disc, floatx8()));
+			floatx8 n0=-b-sq, n1=-b+sq;
+			floatx8 num=select(n0>eps, n0, n1);
+			floatx8 t=num/(floatx8(2)*a);
+			floatx8 hit=(disc>=eps)&(num>eps)&(t>lo)&(t<tBest);
+			int m=moveMask(hit);
+			if (!m) continue;
+			tBest=select(hit, t, tBest);
+			for (int l=0; l<8; l++) if (m>>l&1) ids[l]=i;
+			found|=m;
+		}
+		return found;
 	}
 
-	float3 getNorm() {
-		return normalize(cross(v[1]-v[0], v[2]-v[0]));
+	int intersectTris8(const float3x8& o, const float3x8& d, int start, int count, floatx8& tBest, int ids[8]) const {
+		floatx8 eps(EPSILON), zero, one(1);
+		int found=0;
+		for (int i=start; i<start+count; i++) {
+			float3x8 e1(triE1s.get(i)), e2(triE2s.get(i));
+			float3x8 h=cross(d, e2);
+			floatx8 n=dot(e1, h);
+			floatx8 f=one/n;
+			float3x8 s=o-float3x8(triV0s.get(i));
+			floatx8 u=f*dot(s, h);
+			float3x8 q=cross(s, e1);
+			floatx8 v=f*dot(d, q);
+			floatx8 t=f*dot(e2, q);
+			floatx8 hit=((n>=eps)|(n<=-eps))&(u>=zero)&(u<=one)&(v>=zero)&(u+v<=one)&(t>eps)&(t<tBest);
+			int m=moveMask(hit);
+			if (!m) continue;
+			tBest=select(hit, t, tBest);
+			for (int l=0; l<8; l++) if (m>>l&1) ids[l]=i;
+			found|=m;
+		}
+		return found;
 	}
 
-	float intersectRay(Ray r) override {
-		float3 e1=v[1]-v[0];
-		float3 e2=v[2]-v[0];
-		float3 h=cross(r.dir, e2);
-		float n=dot(e1, h);
-		//ray parallel
-		if (n>-EPSILON&&n<EPSILON) return -1;
-		float f=1/n;
-		float3 s=r.origin-v[0];
-		float u=f*dot(s, h);
-		if (u<0||u>1) return -1;
-		float3 q=cross(s, e1);
-		float v_=f*dot(r.dir, q);
-		if (v_<0||u+v_>1) return -1;
-		float t_=f*dot(e2, q);
-		if (t_>EPSILON) return t_;
-		return -1;
+	//tMax of each lane, 0 where mask is clear.
+	static floatx8 laneMax(float tMax, int mask) {
+		float ts[8];
+		for (int l=0; l<8; l++) ts[l]=mask>>l&1?tMax:0;
+		return floatx8::load(ts);
 	}
 
-	bool getIntersection(Ray r, Hit& hitOut) override {
-		float dist=intersectRay(r);
-		//invalid
-		if (dist<0) return false;
+	//nearest hits of a packet, returns the lanes that hit something.
+	int intersect8(const float3x8& o, const float3x8& d, int mask, floatx8& tOut, int ids[8]) const {
+		floatx8 t=laneMax(INFINITY, mask);
+		int sph[8], tri[8];
+		int sphMask=0, triMask=0;
+		sphBVH.traceLeaves8(o, d, t, mask, [&](int start, int count, int lanes) {
+			sphMask|=intersectSpheres8(o, d, start, count, t, sph);
+		});
+		triBVH.traceLeaves8(o, d, t, mask, [&](int start, int count, int lanes) {
+			triMask|=intersectTris8(o, d, start, count, t, tri);
+		});
+
+		//tris started from the sphere distances, so any tri hit is nearer
+		for (int l=0; l<8; l++) {
+			if (triMask>>l&1) ids[l]=numSpheres()+tri[l];
+			else if (sphMask>>l&1) ids[l]=sph[l];
+		}
+		tOut=t;
+		return sphMask|triMask;
+	}
+
+	//which lanes have anything before their tMax.
+	int occluded8(const float3x8& o, const float3x8& d, const floatx8& tMax, int mask) const {
+		int ids[8];
+		//any lane outside lanes is masked off by the walk
+		auto leaf=[&](int start, int count, bool spheres) {
+			floatx8 t=tMax;
+			return spheres?intersectSpheres8(o, d, start, count, t, ids, EPSILON):intersectTris8(o, d, start, count, t, ids);
+		};
+		int blocked=sphBVH.occludedLeaves8(o, d, tMax, mask, [&](int start, int count, int lanes) { return leaf(start, count, true); });
+		return blocked|triBVH.occludedLeaves8(o, d, tMax, mask&~blocked, [&](int start, int count, int lanes) { return leaf(start, count, false); });
+	}
 
-		//use dist to march dir to hitpos
+	//full hit for the winner of intersect.
+	Hit getHit(const Ray& r, float dist, int id) const {
 		float3 hitPos=r.origin+r.dir*dist;
-		hitOut=Hit(r, dist, hitPos, getNorm(), col, reflective);
-		return true;
+		float3 hitNorm;
+		int mat;
+		if (id<numSpheres()) {
+			//to get norm of UNIFORM surface
+			hitNorm=normalize(hitPos-sphCtrs.get(id));
+			mat=sphMats[id];
+		}
+		else {
+			hitNorm=triNorms.get(id-numSpheres());
+			mat=triMats[id-numSpheres()];
+		}
+		return Hit(r, dist, hitPos, hitNorm, materials[mat].col, materials[mat].reflective);
+	}
+};
+
+//rays waiting on one stage of the bounce pipeline, as arrays so they load 8 at a time.
+//cell is where in the raster the result lands.
+struct RayQueue {
+	float3Array origins, dirs;
+	std::vector<int> cells;
+
+	int size() const { return cells.size(); }
+
+	void clear() {
+		origins.resize(0);
+		dirs.resize(0);
+		cells.clear();
+	}
+
+	void push(float3 origin, float3 dir, int cell) {
+		origins.push_back(origin);
+		dirs.push_back(dir);
+		cells.push_back(cell);
+	}
+};
+
+//rays from a hit toward the sun, with the reflection to follow if the sun is visible.
+struct ShadowQueue : RayQueue {
+	std::vector<float> dists;
+	float3Array reflectDirs;
+	std::vector<char> reflective;
+
+	void clear() {
+		RayQueue::clear();
+		dists.clear();
+		reflectDirs.resize(0);
+		reflective.clear();
+	}
+
+	void push(float3 origin, float3 dir, float dist, int cell, bool reflective_, float3 reflectDir) {
+		RayQueue::push(origin, dir, cell);
+		dists.push_back(dist);
+		reflective.push_back(reflective_);
+		reflectDirs.push_back(reflectDir);
 	}
 };
 
 class Demo : public Engine {
 	public:
-	std::vector<Shape*> shapes;
+	Scene scene;
 
 	float3 camPos, sunPos;
 	float FOV;
 	float camYaw, camPitch;
 	int maxBounces=25;
 
+	//counted per tile through the frame, handed to metrics once at the end
+	//time is summed over threads, so rays per second is per thread
+	struct TraceStats {
+		int rays=0, bounces=0, shadows=0;
+		float primarySec=0, shadowSec=0, bounceSec=0;
+	};
+	Metrics::Id raysId=Metrics::counter("rays", "primary and reflected rays traced");
+	Metrics::Id bouncesId=Metrics::counter("bounces", "reflections followed");
+	Metrics::Id shadowsId=Metrics::counter("shadow rays", "rays cast toward the sun");
+	Metrics::Id primaryRateId=Metrics::gauge("primary rays/s", "per thread, this frame");
+	Metrics::Id shadowRateId=Metrics::gauge("shadow rays/s", "per thread, this frame");
+	Metrics::Id bounceRateId=Metrics::gauge("bounce rays/s", "per thread, this frame");
+
+	//one worker's queues, kept so they stay allocated between frames
+	struct Wavefront {
+		RayQueue bounces;
+		ShadowQueue shadows;
+		TraceStats stats;
+	};
+	std::vector<Wavefront> wavefronts;
+
+	//screen is split into tiles traced in parallel, a pass covers one packet of each
+	static const int TILE_W=16, TILE_H=8;
+
+	//each pass traces one cell of every 4x4 block, spread out so any few done cover the block evenly.
+	//pass 0 alone is 1/16 of the cells, passes 0-3 are 1/4.
+	static const int PASS_STRIDE=4, PASSES=PASS_STRIDE*PASS_STRIDE;
+	const int PASS_OFFSETS[PASSES][2]={
+		{0, 0}, {2, 2}, {2, 0}, {0, 2},
+		{1, 1}, {3, 3}, {3, 1}, {1, 3},
+		{1, 0}, {3, 2}, {3, 0}, {1, 2},
+		{0, 1}, {2, 3}, {2, 1}, {0, 3}
+	};
+
+	//this frame's viewport, corner ray and steps per cell
+	float3 viewCorner, viewStepX, viewStepY;
+
+	//traced cells and hits so far, and the gaps filled in from them with edges drawn
+	std::vector<CHAR_INFO> image, frame;
+	std::vector<char> imageHits, frameHits;
+
+	//view the passes were traced from, anything else starts over at pass 0
+	float3 shownCamPos, shownSunPos;
+	float shownYaw=0, shownPitch=0;
+	int passesDone=0;
+
+	//passes keep going while the next one should fit, always at least one
+	float frameBudgetMs=25;
+
+	//T times the frame on 1 to N threads
+	bool scaling=false, wasScaling=false, showScaling=false;
+	std::vector<float> scalingMs;
+
 	const char* asciiArr=".,~=#&@";
 
 	void dirToUV(float3 dir, float& uOut, float& vOut) {
-		uOut=0.5f+atan2f(dir.x, dir.z)/Maths::TAU;
-		vOut=0.5f-asinf(dir.y)/Maths::PI;
+		//asin(y) as atan2(y, sqrt(1-y*y)), dir is unit length
+		uOut=0.5f+Maths::fast::atan2(dir.x, dir.z)/Maths::TAU;
+		vOut=0.5f-Maths::fast::atan2(dir.y, sqrtf(dir.x*dir.x+dir.z*dir.z))/Maths::PI;
 	}
 
 	//https://math.stackexchange.com/a/13263
@@ -156,75 +447,127 @@ class Demo : public Engine {
 		return normalize(d-n*dot(d, n)*2);
 	}
 
+	//fits the mesh in a box of radius sz around ctr, fans faces into tris.
+	//indices may be negative, counting back from the last vertex.
+	bool loadOBJ(std::string filename, float3 ctr, float sz, int mat) {
+		FILE* file=fopen(filename.c_str(), "r");
+		if (!file) return false;
+
+		std::vector<float3> vtxs;
+		std::vector<int> ixs;
+		AABB3D bounds=AABB3D::empty();
+		char line[1024];
+		while (fgets(line, sizeof(line), file)) {
+			if (line[0]=='v'&&line[1]==' ') {
+				float3 v;
+				if (sscanf(line+2, "%f %f %f", &v.x, &v.y, &v.z)!=3) continue;
+				vtxs.push_back(v);
+				bounds.expand(v);
+			}
+			else if (line[0]=='f'&&line[1]==' ') {
+				//first index of each group, skipping the /uv/norm parts
+				std::vector<int> face;
+				char* c=line+2;
+				while (*c) {
+					char* end;
+					long ix=strtol(c, &end, 10);
+					if (end==c) break;
+					face.push_back(ix<0?(int)vtxs.size()+ix:ix-1);
+					c=end;
+					while (*c&&*c!=' '&&*c!='\t') c++;
+					while (*c==' '||*c=='\t') c++;
+				}
+				for (int i=1; i+1<(int)face.size(); i++) {
+					ixs.push_back(face[0]);
+					ixs.push_back(face[i]);
+					ixs.push_back(face[i+1]);
+				}
+			}
+		}
+		fclose(file);
+		if (vtxs.empty()) return false;
+
+		float3 ext=bounds.max-bounds.min;
+		float maxDim=fmaxf(ext.x, fmaxf(ext.y, ext.z))/2;
+		if (maxDim<=0) maxDim=1;
+		float3 mid=bounds.getCenter();
+		for (auto& v:vtxs) v=ctr+(v-mid)*(sz/maxDim);
+
+		for (int i=0; i+2<(int)ixs.size(); i+=3) {
+			int a=ixs[i], b=ixs[i+1], c=ixs[i+2];
+			int n=vtxs.size();
+			if (a<0||a>=n||b<0||b>=n||c<0||c>=n) continue;
+			scene.addTri(vtxs[a], vtxs[b], vtxs[c], mat);
+		}
+		return true;
+	}
+
 	void setup() override {
-		//plane ease of use functs
-		auto planeXY=[](Tri*& a, Tri*& b, float3 p, float s, short c, bool r) {
+		//plane ease of use functs, a and b are each half's material
+		Scene& sc=scene;
+		auto planeXY=[&sc](float3 p, float s, int a, int b) {
 			s/=2;
 			float3 v0=float3(-s, -s, 0)+p;
 			float3 v1=float3(-s, s, 0)+p;
 			float3 v2=float3(s, -s, 0)+p;
 			float3 v3=float3(s, s, 0)+p;
-			a=new Tri(v0, v1, v2, c, r);
-			b=new Tri(v1, v3, v2, c, r);
+			sc.addTri(v0, v1, v2, a);
+			sc.addTri(v1, v3, v2, b);
 		};
-		auto planeYZ=[](Tri*& a, Tri*& b, float3 p, float s, short c, bool r) {
+		auto planeYZ=[&sc](float3 p, float s, int a, int b) {
 			s/=2;
 			float3 v0=float3(0, -s, -s)+p;
 			float3 v1=float3(0, -s, s)+p;
 			float3 v2=float3(0, s, -s)+p;
 			float3 v3=float3(0, s, s)+p;
-			a=new Tri(v0, v1, v2, c, r);
-			b=new Tri(v1, v3, v2, c, r);
+			sc.addTri(v0, v1, v2, a);
+			sc.addTri(v1, v3, v2, b);
 		};
-		auto planeZX=[](Tri*& a, Tri*& b, float3 p, float s, short c, bool r) {
+		auto planeZX=[&sc](float3 p, float s, int a, int b) {
 			s/=2;
 			float3 v0=float3(-s, 0, -s)+p;
 			float3 v1=float3(s, 0, -s)+p;
 			float3 v2=float3(-s, 0, s)+p;
 			float3 v3=float3(s, 0, s)+p;
-			a=new Tri(v0, v1, v2, c, r);
-			b=new Tri(v1, v3, v2, c, r);
+			sc.addTri(v0, v1, v2, a);
+			sc.addTri(v1, v3, v2, b);
 		};
 
 		//add sphere
-		shapes.push_back(new Sphere(float3(-5, 0, 0), 2.2f, Raster::DARK_RED, false));
+		scene.addSphere(float3(-5, 0, 0), 2.2f, scene.addMaterial(Raster::DARK_RED, false));
 
-		//add tetrahedron
+		//add tetrahedron, or the mesh if one loads
 		float ttSz=1.7f;
-		float3 vt(0, ttSz, 0);
-		float3 vf(0, -ttSz, ttSz);
-		float3 vbl(-ttSz, -ttSz, -ttSz);
-		float3 vbr(ttSz, -ttSz, -ttSz);
-		shapes.push_back(new Tri(vt, vf, vbr, Raster::GREEN, false));
-		shapes.push_back(new Tri(vt, vbr, vbl, Raster::GREEN, false));
-		shapes.push_back(new Tri(vt, vbl, vf, Raster::GREEN, false));
-		shapes.push_back(new Tri(vf, vbl, vbr, Raster::GREEN, false));
+		int green=scene.addMaterial(Raster::GREEN, false);
+		if (SCENE_FILE.empty()||!loadOBJ(SCENE_FILE, float3(0), ttSz, green)) {
+			float3 vt(0, ttSz, 0);
+			float3 vf(0, -ttSz, ttSz);
+			float3 vbl(-ttSz, -ttSz, -ttSz);
+			float3 vbr(ttSz, -ttSz, -ttSz);
+			scene.addTri(vt, vf, vbr, green);
+			scene.addTri(vt, vbr, vbl, green);
+			scene.addTri(vt, vbl, vf, green);
+			scene.addTri(vf, vbl, vbr, green);
+		}
 
 		//groundplane
-		Tri* gn[2];
-		planeZX(gn[0], gn[1], float3(0, -4, 0), 8, Raster::MAGENTA, false);
-		gn[1]->col=Raster::DARK_YELLOW;
-		//add
-		shapes.push_back(gn[0]); shapes.push_back(gn[1]);
+		planeZX(float3(0, -4, 0), 8, scene.addMaterial(Raster::MAGENTA, false), scene.addMaterial(Raster::DARK_YELLOW, false));
 
 		//side mirror
-		Tri* mr[2];
-		planeXY(mr[0], mr[1], float3(0, 0, 4), 8, Raster::WHITE, true);
-		//add
-		shapes.push_back(mr[0]); shapes.push_back(mr[1]);
+		int mirror=scene.addMaterial(Raster::WHITE, true);
+		planeXY(float3(0, 0, 4), 8, mirror, mirror);
 
 		//blue cube
-		Tri* cb[6][2];
+		int cyan=scene.addMaterial(Raster::DARK_CYAN, false);
 		float sz=2;
 		float3 cbCtr(5, 0, 0);
-		planeZX(cb[0][0], cb[0][1], float3(0, sz/2, 0)+cbCtr, sz, Raster::DARK_CYAN, false);//front
-		planeZX(cb[1][0], cb[1][1], float3(0, -sz/2, 0)+cbCtr, sz, Raster::DARK_CYAN, false);//back
-		planeYZ(cb[2][0], cb[2][1], float3(sz/2, 0, 0)+cbCtr, sz, Raster::DARK_CYAN, false);//left
-		planeYZ(cb[3][0], cb[3][1], float3(-sz/2, 0, 0)+cbCtr, sz, Raster::DARK_CYAN, false);//right
-		planeXY(cb[4][0], cb[4][1], float3(0, 0, sz/2)+cbCtr, sz, Raster::DARK_CYAN, false);//top
-		planeXY(cb[5][0], cb[5][1], float3(0, 0, -sz/2)+cbCtr, sz, Raster::DARK_CYAN, false);//bottom
-		//add
-		for (int f=0; f<6; f++) { shapes.push_back(cb[f][0]); shapes.push_back(cb[f][1]); }
+		planeZX(float3(0, sz/2, 0)+cbCtr, sz, cyan, cyan);//front
+		planeZX(float3(0, -sz/2, 0)+cbCtr, sz, cyan, cyan);//back
+		planeYZ(float3(sz/2, 0, 0)+cbCtr, sz, cyan, cyan);//left
+		planeYZ(float3(-sz/2, 0, 0)+cbCtr, sz, cyan, cyan);//right
+		planeXY(float3(0, 0, sz/2)+cbCtr, sz, cyan, cyan);//top
+		planeXY(float3(0, 0, -sz/2)+cbCtr, sz, cyan, cyan);//bottom
+		scene.build();
 
 		//initialize other stuff
 		camPos=float3(0, 0, -5);
@@ -263,72 +606,256 @@ class Demo : public Engine {
 		//set sunpos if enter pressed
 		if (getKey(VK_RETURN)) sunPos=camPos;
 
+		//toggle scaling report
+		scaling=getKey('T');
+		if (scaling&&!wasScaling) {
+			showScaling=!showScaling;
+			scalingMs.clear();
+		}
+		wasScaling=scaling;
+
 		camPitch=Maths::clamp(camPitch, EPSILON, Maths::PI-EPSILON);
 	}
 
-	bool traceRay(Ray rayToUse, std::vector<Shape*> shapeSetToUse, short& charOut, short& colorOut) {
-		//sort
-		Hit chosenHit;
-		float record=INFINITY;
-		bool shapeFound=false;
-		for (Shape* s:shapeSetToUse) {//we love auto!
-			Hit ix;
-			if (s->getIntersection(rayToUse, ix)) {
-				if (ix.dist<record) {
-					record=ix.dist;
-					chosenHit=ix;
-					shapeFound=true;
+	//color and diffuse char of a hit, before shadows.
+	void shadeHit(const Hit& hit, short& charOut, short& colorOut) {
+		//use closest shape
+		colorOut=hit.col;
+
+		//diffuse shade
+		float3 sunDir=normalize(sunPos-hit.pos);
+		//abs so tris are same from each side
+		float diffuse=abs(dot(sunDir, hit.norm));
+		int asi=Maths::clamp(diffuse*7, 0, 6);
+		charOut=diffuse<0?' ':asciiArr[asi];
+	}
+
+	//make some circular pattern for the rays that hit no shapes.
+	void shadeSky(float3 dir, short& charOut, short& colorOut) {
+		float u, v;
+		dirToUV(dir, u, v);
+
+		int iu=u*26;
+		int iv=v*20;
+		charOut='a'+iu;
+
+		bool checker=iu%2==iv%2;
+		colorOut=checker?Raster::WHITE:Raster::DARK_GREY;
+	}
+
+	//sky or shaded hit into cell, hits queue their shadow ray.
+	void shadeCell(const Ray& ray, bool hit, float dist, int id, int cell, CHAR_INFO* buf, ShadowQueue& shadows) {
+		short c, col;
+		if (!hit) {
+			shadeSky(ray.dir, c, col);
+		}
+		else {
+			Hit h=scene.getHit(ray, dist, id);
+			shadeHit(h, c, col);
+			float3 toSun=sunPos-h.pos;
+			float3 reflectDir=h.reflective?reflectVec(ray.dir, h.norm):float3(0);
+			shadows.push(h.pos, normalize(toSun), length(toSun), cell, h.reflective, reflectDir);
+		}
+		buf[cell].Char.UnicodeChar=c;
+		buf[cell].Attributes=col;
+	}
+
+	//shadow queue 8 at a time. shadowed cells go dark, lit reflective ones bounce.
+	void runShadows(ShadowQueue& shadows, RayQueue& bounces, CHAR_INFO* buf, TraceStats& stats) {
+		auto start=std::chrono::steady_clock::now();
+		for (int i=0; i<shadows.size(); i+=8) {
+			int n=shadows.size()-i<8?shadows.size()-i:8;
+			int blocked=scene.occluded8(shadows.origins.load8(i), shadows.dirs.load8(i), floatx8::loadPartial(&shadows.dists[i], n), (1<<n)-1);
+			for (int l=0; l<n; l++) {
+				int k=i+l;
+				//so make the shadow dark!
+				if (blocked>>l&1) buf[shadows.cells[k]].Char.UnicodeChar=' ';
+				else if (shadows.reflective[k]) bounces.push(shadows.origins.get(k), shadows.reflectDirs.get(k), shadows.cells[k]);
+			}
+		}
+		stats.shadows+=shadows.size();
+		stats.shadowSec+=std::chrono::duration<float>(std::chrono::steady_clock::now()-start).count();
+		shadows.clear();
+	}
+
+	//traces the cells of tile t that pass p covers into image, tiles never share a cell.
+	//each stage runs over the whole tile before the next: primary packets, then their shadows,
+	//then reflections one ray at a time since they scatter, then their shadows, until maxBounces.
+	void renderTile(int t, int p, Wavefront& wf) {
+		int tilesX=(width+TILE_W-1)/TILE_W;
+		int x0=t%tilesX*TILE_W, j0=t/tilesX*TILE_H;
+		int x1=x0+TILE_W<width?x0+TILE_W:width;
+		int j1=j0+TILE_H<height?j0+TILE_H:height;
+		CHAR_INFO* buf=image.data();
+
+		//cells of the pass go 8 at a time, neighbors start out close together
+		float dx[8], dy[8], dz[8];
+		int cells[8], n=0;
+		auto flush=[&] {
+			float3x8 dir=normalize(float3x8::loadPartial(dx, dy, dz, n));
+			floatx8 dist;
+			int ids[8];
+			int hitMask=scene.intersect8(float3x8(camPos), dir, (1<<n)-1, dist, ids);
+			float ts[8];
+			dir.store(dx, dy, dz);
+			dist.store(ts);
+			for (int l=0; l<n; l++) {
+				imageHits[cells[l]]=hitMask>>l&1;
+				shadeCell(Ray(camPos, float3(dx[l], dy[l], dz[l])), hitMask>>l&1, ts[l], ids[l], cells[l], buf, wf.shadows);
+			}
+			wf.stats.rays+=n;
+			n=0;
+		};
+
+		auto start=std::chrono::steady_clock::now();
+		for (int x=x0+PASS_OFFSETS[p][0]; x<x1; x+=PASS_STRIDE) {
+			for (int j=j0+PASS_OFFSETS[p][1]; j<j1; j+=PASS_STRIDE) {
+				float3 pij=viewCorner+viewStepX*x+viewStepY*j;
+				dx[n]=pij.x; dy[n]=pij.y; dz[n]=pij.z;
+				//y flipped
+				cells[n++]=x+(height-1-j)*width;
+				if (n==8) flush();
+			}
+		}
+		if (n) flush();
+		wf.stats.primarySec+=std::chrono::duration<float>(std::chrono::steady_clock::now()-start).count();
+		runShadows(wf.shadows, wf.bounces, buf, wf.stats);
+
+		for (int b=0; b<maxBounces&&wf.bounces.size(); b++) {
+			start=std::chrono::steady_clock::now();
+			for (int i=0; i<wf.bounces.size(); i++) {
+				Ray ray(wf.bounces.origins.get(i), wf.bounces.dirs.get(i));
+				float dist;
+				int id;
+				bool hit=scene.intersect(ray, INFINITY, dist, id);
+				shadeCell(ray, hit, dist, id, wf.bounces.cells[i], buf, wf.shadows);
+			}
+			wf.stats.rays+=wf.bounces.size();
+			wf.stats.bounces+=wf.bounces.size();
+			wf.stats.bounceSec+=std::chrono::duration<float>(std::chrono::steady_clock::now()-start).count();
+			wf.bounces.clear();
+			runShadows(wf.shadows, wf.bounces, buf, wf.stats);
+		}
+		wf.bounces.clear();
+	}
+
+	//one pass over the whole screen on up to threads threads, the same cells whatever the count.
+	void renderPass(int p, int threads, TraceStats& total) {
+		int tileNum=((width+TILE_W-1)/TILE_W)*((height+TILE_H-1)/TILE_H);
+		std::atomic<int> next(0);
+		if ((int)wavefronts.size()<threads) wavefronts.resize(threads);
+		tasks.parallelFor(threads, [&](int w) {
+			int t;
+			wavefronts[w].stats=TraceStats();
+			while ((t=next++)<tileNum) renderTile(t, p, wavefronts[w]);
+		});
+
+		for (int w=0; w<threads; w++) {
+			const TraceStats& s=wavefronts[w].stats;
+			total.rays+=s.rays;
+			total.bounces+=s.bounces;
+			total.shadows+=s.shadows;
+			total.primarySec+=s.primarySec;
+			total.shadowSec+=s.shadowSec;
+			total.bounceSec+=s.bounceSec;
+		}
+	}
+
+	//frame from the passes done so far, cells not traced yet copy the nearest one that was.
+	void compose() {
+		//per spot in a block, the closest pass done so far, the earlier one on ties
+		int fillFrom[PASS_STRIDE*PASS_STRIDE];
+		for (int i=0; i<PASS_STRIDE*PASS_STRIDE; i++) {
+			int bx=i%PASS_STRIDE, bj=i/PASS_STRIDE, best=INT_MAX;
+			for (int p=0; p<passesDone; p++) {
+				int ox=PASS_OFFSETS[p][0]-bx, oj=PASS_OFFSETS[p][1]-bj;
+				if (ox*ox+oj*oj<best) {
+					best=ox*ox+oj*oj;
+					fillFrom[i]=p;
 				}
 			}
 		}
 
-		//color pixel accordingly
-		if (shapeFound) {
-			//use closest shape
-			colorOut=chosenHit.col;
-
-			//diffuse shade
-			float3 sunDir=normalize(sunPos-chosenHit.pos);
-			//abs so tris are same from each side
-			float diffuse=abs(dot(sunDir, chosenHit.norm));
-			int asi=Maths::clamp(diffuse*7, 0, 6);
-			charOut=diffuse<0?' ':asciiArr[asi];
-
-			//shadows, find any shape inbetween the hit and the sun
-			Ray shadowRay=Ray(chosenHit.pos, sunDir);
-			for (Shape* s:shapes) {
-				float dist=s->intersectRay(shadowRay);
-				if (dist>EPSILON) {//is there an intersection?
-					//so make the shadow dark!
-					charOut=' ';
-					return true;
+		tasks.parallelFor(height, [&](int y) {
+			int j=height-1-y;
+			for (int x=0; x<width; x++) {
+				int o=fillFrom[(j%PASS_STRIDE)*PASS_STRIDE+x%PASS_STRIDE];
+				int sx=x-x%PASS_STRIDE+PASS_OFFSETS[o][0];
+				int sj=j-j%PASS_STRIDE+PASS_OFFSETS[o][1];
+				//block cut off by the screen edge, its first pass cell is always there
+				if (sx>=width||sj>=height) {
+					sx=x-x%PASS_STRIDE;
+					sj=j-j%PASS_STRIDE;
 				}
+				int src=sx+(height-1-sj)*width;
+				frame[x+y*width]=image[src];
+				frameHits[x+y*width]=imageHits[src];
 			}
+		});
 
-			if (chosenHit.reflective) {
-				traceRay(Ray(chosenHit.pos, reflectVec(rayToUse.dir, chosenHit.norm)), shapeSetToUse, charOut, colorOut);
+		//edge detection, one row each
+		tasks.parallelFor(height, [&](int y) {
+			for (int x=0; x<width; x++) {
+				bool diff=false;
+				bool curr=frameHits[x+y*width];
+				//"highlight" any differences between pixels
+				if (x>1) diff|=(curr&&!frameHits[x-1+y*width]);//left or
+				if (y>1) diff|=(curr&&!frameHits[x+y*width-width]);//up or
+				if (x<width-2) diff|=(curr&&!frameHits[x+1+y*width]);//right or
+				if (y<height-2) diff|=(curr&&!frameHits[x+y*width+width]);//down
+				if (diff) {
+					frame[x+y*width].Char.UnicodeChar=0x2588;
+					frame[x+y*width].Attributes=Raster::WHITE;
+				}
 			}
-			return true;
-		}
-		else {
-			//make some circular pattern for the rays that hit no shapes.
-			float u, v;
-			dirToUV(rayToUse.dir, u, v);
+		});
+	}
 
-			int iu=u*26;
-			int iv=v*20;
-			charOut='a'+iu;
+	//times every pass on 1 to N threads, best of a few runs each, and writes it out too.
+	void runScaling() {
+		//every pass is traced in each run, so compose from all of them
+		passesDone=PASSES;
+		int maxThreads=std::thread::hardware_concurrency();
+		if (maxThreads<1) maxThreads=1;
+		for (int n=1; n<=maxThreads; n++) {
+			float best=INFINITY;
+			for (int r=0; r<3; r++) {
+				TraceStats unused;
+				auto start=std::chrono::steady_clock::now();
+				for (int p=0; p<PASSES; p++) renderPass(p, n, unused);
+				compose();
+				float ms=std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now()-start).count();
+				if (ms<best) best=ms;
+			}
+			scalingMs.push_back(best);
+		}
 
-			bool checker=iu%2==iv%2;
-			colorOut=checker?Raster::WHITE:Raster::DARK_GREY;
-			return false;
+		FILE* file=fopen("raytracer_scaling.csv", "w");
+		if (!file) return;
+		fprintf(file, "threads,ms,speedup,efficiency\n");
+		for (int i=0; i<(int)scalingMs.size(); i++) {
+			float speedup=scalingMs[0]/scalingMs[i];
+			fprintf(file, "%d,%.3f,%.3f,%.3f\n", i+1, scalingMs[i], speedup, speedup/(i+1));
 		}
+		fclose(file);
 	}
 
 	void draw(Raster& rst) override {
-		//background
-		rst.setChar(' ');
-		rst.fillRect(0, 0, width, height);
+		//anything that changes the image starts refinement over
+		bool sizeChanged=(int)image.size()!=width*height;
+		if (sizeChanged||!(camPos==shownCamPos)||!(sunPos==shownSunPos)||camYaw!=shownYaw||camPitch!=shownPitch) {
+			shownCamPos=camPos;
+			shownSunPos=sunPos;
+			shownYaw=camYaw;
+			shownPitch=camPitch;
+			passesDone=0;
+		}
+		if (sizeChanged) {
+			image.resize(width*height);
+			imageHits.resize(width*height);
+			frame.resize(width*height);
+			frameHits.resize(width*height);
+		}
 
 		//https://en.wikipedia.org/wiki/Ray_tracing_(graphics)
 		//calc viewport
@@ -348,57 +875,68 @@ class Demo : public Engine {
 		float gy=gx*((height-1.0f)/(width-1.0f));
 
 		//stepping vectors
-		float3 qx=bn*(2*gx/(width-1));
-		float3 qy=vn*(2*gy/(height-1));
-		float3 p1m=tn-bn*gx-vn*gy;
-
-		bool* hitGrid=new bool[width*height];
-		for (int i=0, x=0; i<width; i++, x++) {
-			//y flipped
-			for (int j=0, y=height-1; j<height; j++, y--) {
-				float3 pij=p1m+qx*i+qy*j;
-				Ray ray=Ray(camPos, normalize(pij));
-
-				//calculate color and symbol to use for this pixel
-				short charToUse;
-				short colorToUse;
-				hitGrid[x+y*width]=traceRay(ray, shapes, charToUse, colorToUse);
-				//set pixel
-				rst.setChar(charToUse);
-				rst.setColor(colorToUse);
-				//and draw it
-				rst.putPixel(x, y);
-			}
+		viewStepX=bn*(2*gx/(width-1));
+		viewStepY=vn*(2*gy/(height-1));
+		viewCorner=tn-bn*gx-vn*gy;
+
+		if (showScaling&&scalingMs.empty()) runScaling();
+
+		//at least one pass, then more while the next should still fit in the budget
+		TraceStats stats;
+		int threads=std::thread::hardware_concurrency();
+		auto start=std::chrono::steady_clock::now();
+		float passMs=0;
+		bool traced=false;
+		while (passesDone<PASSES) {
+			float elapsed=std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now()-start).count();
+			if (traced&&elapsed+passMs>frameBudgetMs) break;
+
+			renderPass(passesDone, threads>0?threads:1, stats);
+			passesDone++;
+			passMs=std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now()-start).count()-elapsed;
+			traced=true;
 		}
+		if (traced) compose();
 
-		//edge detection
-		rst.setChar(0x2588);
-		rst.setColor(Raster::WHITE);
-		for (int x=0; x<width; x++) {
-			for (int y=0; y<height; y++) {
-				bool diff=false;
-				bool curr=hitGrid[x+y*width];
-				//"highlight" any differences between pixels
-				if (x>1) diff|=(curr&&!hitGrid[x-1+y*width]);//left or
-				if (y>1) diff|=(curr&&!hitGrid[x+y*width-width]);//up or
-				if (x<width-2) diff|=(curr&&!hitGrid[x+1+y*width]);//right or
-				if (y<height-2) diff|=(curr&&!hitGrid[x+y*width+width]);//down
-				if (diff) rst.putPixel(x, y);
-			}
-		}
-		delete[] hitGrid;
+		//finished frames are only copied
+		memcpy(rst.getBuffer(), frame.data(), sizeof(CHAR_INFO)*width*height);
+
+		Metrics::add(raysId, stats.rays);
+		Metrics::add(bouncesId, stats.bounces);
+		Metrics::add(shadowsId, stats.shadows);
+		auto rate=[](int rays, float sec) { return sec>0?rays/sec:0; };
+		Metrics::set(primaryRateId, rate(stats.rays-stats.bounces, stats.primarySec));
+		Metrics::set(shadowRateId, rate(stats.shadows, stats.shadowSec));
+		Metrics::set(bounceRateId, rate(stats.bounces, stats.bounceSec));
 
 		//show fps
 		rst.setChar(' ');
-		rst.fillRect(0, 0, 16, 4);
+		rst.fillRect(0, 0, 16, 5);
 		rst.setColor(Raster::WHITE);
 		rst.drawString(0, 0, "FPS: "+std::to_string((int)framesPerSecond));
 		rst.drawString(0, 1, "yaw: "+std::to_string(camYaw));
 		rst.drawString(0, 2, "pitch: "+std::to_string(camPitch));
+		rst.drawString(0, 3, "prims: "+std::to_string(scene.size()));
+		rst.drawString(0, 4, "passes: "+std::to_string(passesDone)+"/"+std::to_string(PASSES));
+
+		//threads, frame time, speedup over one
+		if (showScaling) {
+			rst.setChar(' ');
+			rst.fillRect(0, 6, 24, scalingMs.size()+1);
+			rst.drawString(0, 6, "threads     ms  speedup");
+			for (int i=0; i<(int)scalingMs.size(); i++) {
+				char row[32];
+				snprintf(row, sizeof(row), "%7d %6.1f %7.2fx", i+1, scalingMs[i], scalingMs[0]/scalingMs[i]);
+				rst.drawString(0, 7+i, row);
+			}
+		}
 	}
 };
 
-int main() {
+int main(int argc, char** argv) {
+	//raytracer.exe [scene.obj]
+	if (argc>1) SCENE_FILE=argv[1];
+
 	//init custom graphics engine
 	Demo d;
 	d.startFullscreen(8);
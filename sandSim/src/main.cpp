@@ -2,6 +2,8 @@
 
 #include "Engine.h"
 #include "maths/Maths.h"
+#include "maths/Random.h"
+#include "io/Snapshot.h"
 using namespace displib;
 
 enum ParticleType {
@@ -16,6 +18,8 @@ class Demo : public Engine {
 	ParticleType* particleGrid;
 	float timer=0;
 	float timePerStep=0.01f;
+	bool save=false, wasSave=false;
+	bool load=false, wasLoad=false;
 
 	void setup() override {
 		setTitle("Sand & Water Simulation");
@@ -35,7 +39,27 @@ class Demo : public Engine {
 		}
 	}
 
+	void saveSnapshot() {
+		SnapshotWriter out("sandSim.snap");
+		out.put("grid", particleGrid, width*height);
+		out.close();
+	}
+
+	void loadSnapshot() {
+		//only fits back into a grid of the same size
+		SnapshotReader in("sandSim.snap");
+		in.get("grid", particleGrid, width*height);
+	}
+
 	void update(float dt) override {
+		//snapshot to file and back
+		save=getKey(VK_F5);
+		if (save&&!wasSave) saveSnapshot();
+		wasSave=save;
+		load=getKey(VK_F9);
+		if (load&&!wasLoad) loadSnapshot();
+		wasLoad=load;
+
 		//ez funcs
 		auto pgSet=[&](int x, int y, ParticleType pt) { particleGrid[ix(x, y)]=pt; };
 		auto pgGet=[&](int x, int y, ParticleType pt) { return particleGrid[ix(x, y)]==pt; };
@@ -65,6 +89,9 @@ class Demo : public Engine {
 			ParticleType* gridCopy=new ParticleType[width*height];
 			memcpy(gridCopy, particleGrid, sizeof(ParticleType)*width*height);//copy "old" to new
 
+			//one stream lookup per step, not per grain
+			Random& rng=Random::local();
+
 			//sand behavior:
 			for (int x=0; x<width; x++) {
 				for (int y=0; y<height; y++) {
@@ -72,14 +99,14 @@ class Demo : public Engine {
 					if (curr!=Barrier) {//dont "update" barriers
 						//sand behavior:
 						if (curr==Sand) {//if free move there:
-							int l_r=Maths::random()>0.5?-1:1;//some randomness
+							int l_r=rng.next()&1?-1:1;//some randomness
 							if (pgGet(x, y+1, Air)) { pgSet(x, y+1, Sand); pgSet(x, y, Air); }//down
 							else if (pgGet(x-l_r, y+1, Air)) { pgSet(x-l_r, y+1, Sand); pgSet(x, y, Air); }//down left or right?
 							else if (pgGet(x+l_r, y+1, Air)) { pgSet(x+l_r, y+1, Sand); pgSet(x, y, Air); }//down the other side
 						} 
 						//water behavior:
 						else if (curr==Water) {//if free move there:
-							int l_r=Maths::random()>0.5?-1:1;//some randomness
+							int l_r=rng.next()&1?-1:1;//some randomness
 							if (pgGet(x, y+1, Air)) { pgSet(x, y+1, Water); pgSet(x, y, Air); }//down
 							else if (pgGet(x-l_r, y+1, Air)) { pgSet(x-l_r, y+1, Water); pgSet(x, y, Air); }//down left or right?
 							else if (pgGet(x+l_r, y+1, Air)) { pgSet(x+l_r, y+1, Water); pgSet(x, y, Air); }//down the other side
@@ -146,7 +173,7 @@ class Demo : public Engine {
 };
 
 int main() {
-	srand(time(NULL));
+	Random::seed(time(NULL));
 
 	//init custom graphics engine
 	Demo d=Demo();
@@ -4,17 +4,11 @@
 
 #include "Engine.h"
 #include "maths/Maths.h"
+#include "maths/Random.h"
 #include "geom/AABB3D.h"
+#include "geom/Camera3D.h"
 using namespace displib;
 
-//i really havent a clue where i got this XD
-float2 projfloat3(float3 v, float yaw, float pitch, float zoom) {
-	return float2(
-		sinf(yaw)*v.x-cosf(yaw)*v.z,
-		(cosf(yaw)*v.x+sinf(yaw)*v.z)*cosf(pitch)+sinf(pitch)*v.y
-	)*zoom;
-}
-
 //for some pemdas reason, this cant be a preprocessor define.
 int ix(int x, int y, int z, int w, int d) {
 	return x+z*w+y*w*d;
@@ -113,6 +107,10 @@ class Demo : public Engine {
 	tri* tris;
 	float camYaw=2.074755f, camPitch=-1.060102f;
 	float camZoom=82.45f;
+	Camera3D cam;
+	std::vector<float3> ptcPos;
+	std::vector<float2> projected;
+	std::vector<float> depths;
 
 	bool showOutline=true;
 	bool oDown=false;
@@ -122,6 +120,7 @@ class Demo : public Engine {
 
 	void setup() override {
 		ctr=float2(width/2, height/2);
+		cam.pool=&tasks;
 
 		lightDir=normalize(float3(1, -1, 1));
 
@@ -296,18 +295,26 @@ class Demo : public Engine {
 		rst.setChar(' ');
 		rst.fillRect(0, 0, width, height);
 
+		//project every particle once
+		cam.setOrbit(camYaw, camPitch, 5, camZoom, ctr);
+		ptcPos.resize(ptcNum);
+		projected.resize(ptcNum);
+		depths.resize(ptcNum);
+		for (int i=0; i<ptcNum; i++) ptcPos[i]=ptcs[i].pos;
+		cam.projectBatch(ptcPos.data(), projected.data(), depths.data(), ptcNum);
+
 		//draw bounds
 		rst.setChar(0x2588);
 		float nx=bounds.min.x, ny=bounds.min.y, nz=bounds.min.z;
 		float xx=bounds.max.x, xy=bounds.max.y, xz=bounds.max.z;
-		float2 nnn=projfloat3(float3(nx, ny, nz), camYaw, camPitch, camZoom)+ctr;
-		float2 nnx=projfloat3(float3(nx, ny, xz), camYaw, camPitch, camZoom)+ctr;
-		float2 nxn=projfloat3(float3(nx, xy, nz), camYaw, camPitch, camZoom)+ctr;
-		float2 nxx=projfloat3(float3(nx, xy, xz), camYaw, camPitch, camZoom)+ctr;
-		float2 xnn=projfloat3(float3(xx, ny, nz), camYaw, camPitch, camZoom)+ctr;
-		float2 xnx=projfloat3(float3(xx, ny, xz), camYaw, camPitch, camZoom)+ctr;
-		float2 xxn=projfloat3(float3(xx, xy, nz), camYaw, camPitch, camZoom)+ctr;
-		float2 xxx=projfloat3(float3(xx, xy, xz), camYaw, camPitch, camZoom)+ctr;
+		float2 nnn=cam.project(float3(nx, ny, nz));
+		float2 nnx=cam.project(float3(nx, ny, xz));
+		float2 nxn=cam.project(float3(nx, xy, nz));
+		float2 nxx=cam.project(float3(nx, xy, xz));
+		float2 xnn=cam.project(float3(xx, ny, nz));
+		float2 xnx=cam.project(float3(xx, ny, xz));
+		float2 xxn=cam.project(float3(xx, xy, nz));
+		float2 xxx=cam.project(float3(xx, xy, xz));
 		//top
 		rst.drawLine(nnn, nnx);
 		rst.drawLine(nnx, xnx);
@@ -328,15 +335,15 @@ class Demo : public Engine {
 		std::vector<tri> trisToDraw;
 		for (int i=0; i<triNum; i++) {
 			tri& t=tris[i];
-			//culling
-			if (dot(t.getNorm(), t.getA().pos-camPos)<0) {
+			//culling by screen winding
+			if (Camera3D::isFrontFacing(projected[t.a-ptcs], projected[t.b-ptcs], projected[t.c-ptcs])) {
 				trisToDraw.push_back(t);
 			}
 		}
 
 		//"painters"-ish algo to sort by what is closer to the "camera"
 		sort(trisToDraw.begin(), trisToDraw.end(), [&](tri& a, tri& b) {
-			return length(a.getAvgPos()-camPos)>length(b.getAvgPos()-camPos);
+			return depths[a.a-ptcs]+depths[a.b-ptcs]+depths[a.c-ptcs]>depths[b.a-ptcs]+depths[b.b-ptcs]+depths[b.c-ptcs];
 		});
 
 		//"project" tris
@@ -351,9 +358,9 @@ class Demo : public Engine {
 			rst.setChar(asciiArr[asi]);
 
 			//get projected coords
-			float2 a=projfloat3(t.getA().pos, camYaw, camPitch, camZoom)+ctr;
-			float2 b=projfloat3(t.getB().pos, camYaw, camPitch, camZoom)+ctr;
-			float2 c=projfloat3(t.getC().pos, camYaw, camPitch, camZoom)+ctr;
+			float2 a=projected[t.a-ptcs];
+			float2 b=projected[t.b-ptcs];
+			float2 c=projected[t.c-ptcs];
 			rst.fillTriangle(a, b, c);
 
 			if (showOutline) {
@@ -368,7 +375,7 @@ class Demo : public Engine {
 };
 
 int main() {
-	srand(time(NULL));
+	Random::seed(time(NULL));
 
 	//init custom graphics engine
 	Demo d=Demo();
@@ -3,6 +3,8 @@
 
 #include "Engine.h"
 #include "maths/Maths.h"
+#include "maths/Random.h"
+#include "io/Sprite.h"
 using namespace displib;
 
 struct ptc {
@@ -81,6 +83,12 @@ class Demo : public Engine {
 	};
 	int currX, currY, currRot, currNum, nextNum, heldNum;
 
+	//baked static art, digits are always ' ' on white whatever the raster state
+	Sprite digitSprites[11];
+	//each tetro in its current color, rebaked when the level shifts the colors
+	Sprite statSprites[7];
+	int statShift=-1;
+
 	//key stuff
 	float keyStartTime=0.19f, keyRepeatTime=0.058f;
 	float downTime=0, leftTime=0, rightTime=0;
@@ -114,6 +122,23 @@ class Demo : public Engine {
 		return (num+level/3*2)%7;
 	}
 
+	//bakes every tetro in its color for the statistics, only once the colors change
+	void bakeStats() {
+		if (statShift==level/3*2%7) return;
+		statShift=level/3*2%7;
+		for (int n=0; n<7; n++) {
+			Sprite::bake(statSprites[n], 4, 4, [&](Raster& rst) {
+				rst.setChar(0x2588);
+				rst.setColor(colors[numToCol(n)]);
+				for (int i=0; i<4; i++) {
+					for (int j=0; j<4; j++) {
+						if (tetros[n*16+tIX(i, j, 0)]) rst.putPixel(i, j);
+					}
+				}
+			});
+		}
+	}
+
 	//determines if conceptual piece can fit in grid
 	bool tetroCanFit(int x, int y, int r) {
 		for (int i=0; i<4; i++) {
@@ -164,6 +189,17 @@ class Demo : public Engine {
 		//clear stats
 		memset(stats, 0, sizeof(int)*7);
 
+		//bake digits
+		for (int d=0; d<11; d++) {
+			digitSprites[d]=Sprite::bake(3, 5, [&](Raster& rst) {
+				for (int i=0; i<3; i++) {
+					for (int j=0; j<5; j++) {
+						if (digits[i+j*3+d*15]) rst.putPixel(i, j);
+					}
+				}
+			});
+		}
+
 		//first piece
 		resetPiece();
 		getNewPiece();
@@ -354,7 +390,7 @@ class Demo : public Engine {
 		setTitle("Tetris! -ish. @ "+std::to_string((int)framesPerSecond)+"fps");
 	}
 
-	void draw(Raster& rst) override {
+	void drawFrame(Raster& rst) {
 		//background
 		rst.setChar(0x2588);
 		rst.setColor(Raster::DARK_GREY);
@@ -371,6 +407,44 @@ class Demo : public Engine {
 		rst.drawRect(23, 3, width-46, height-6);
 		//field text
 		rst.drawString(23, 2, "Playing Field");
+
+		//held background
+		rst.setChar(' ');
+		rst.fillRect(4, 4, 16, 16);
+		//held edge
+		rst.setChar(0x2588);
+		rst.drawRect(3, 3, 18, 18);
+		//held text
+		rst.drawString(3, 2, "Held Piece");
+
+		//next background
+		rst.setChar(' ');
+		rst.fillRect(68, 4, 16, 16);
+		//next edge
+		rst.setChar(0x2588);
+		rst.drawRect(67, 3, 18, 18);
+		//next text
+		rst.drawString(67, 2, "Next Piece");
+
+		//score/level/lines text
+		rst.drawString(3, 69, "Score");
+		rst.drawString(3, 77, "Level");
+		rst.drawString(3, 85, "Lines");
+
+		//statistics background
+		rst.setChar(' ');
+		rst.fillRect(71, 39, 10, 36);
+		//stats edge
+		rst.setChar(0x2588);
+		rst.drawRect(70, 38, 12, 38);
+		//stats text
+		rst.drawString(70, 37, "Statistics");
+	}
+
+	void draw(Raster& rst) override {
+		//board frame never changes
+		rst.drawLayer(0, [&](Raster& lyr) { drawFrame(lyr); });
+
 		//field
 		for (int i=0; i<cols; i++) {
 			for (int j=0; j<rows; j++) {
@@ -414,15 +488,6 @@ class Demo : public Engine {
 			}
 		}
 
-		//held background
-		rst.setChar(' ');
-		rst.setColor(Raster::WHITE);
-		rst.fillRect(4, 4, 16, 16);
-		//held edge
-		rst.setChar(0x2588);
-		rst.drawRect(3, 3, 18, 18);
-		//held text
-		rst.drawString(3, 2, "Held Piece");
 		//held piece
 		rst.setChar(0x2588);
 		rst.setColor(colors[numToCol(heldNum)]);
@@ -436,15 +501,6 @@ class Demo : public Engine {
 			}
 		}
 
-		//next background
-		rst.setChar(' ');
-		rst.setColor(Raster::WHITE);
-		rst.fillRect(68, 4, 16, 16);
-		//next edge
-		rst.setChar(0x2588);
-		rst.drawRect(67, 3, 18, 18);
-		//next text
-		rst.drawString(67, 2, "Next Piece");
 		//next piece
 		rst.setChar(0x2588);
 		rst.setColor(colors[numToCol(nextNum)]);
@@ -481,33 +537,17 @@ class Demo : public Engine {
 		showInt(rst, 3, 71, score);
 		showInt(rst, 3, 79, level);
 		showInt(rst, 3, 87, lines);
-		//score/level/lines text
-		rst.drawString(3, 69, "Score");
-		rst.drawString(3, 77, "Level");
-		rst.drawString(3, 85, "Lines");
 
-		//statistics background
-		rst.fillRect(71, 39, 10, 36);
-		//stats edge
+		//statistics
+		bakeStats();
 		rst.setChar(0x2588);
-		rst.drawRect(70, 38, 12, 38);
 		for (int n=0, x=72, y=40; n<7; n++) {
-			for (int i=0; i<4; i++) {
-				for (int j=0; j<4; j++) {
-					if (tetros[n*16+tIX(i, j, 0)]) {
-						//show tetro
-						rst.setColor(colors[numToCol(n)]);
-						rst.putPixel(x+i, y+j);
-						//info
-						rst.setColor(Raster::WHITE);
-						rst.drawString(x+5, y, std::to_string(stats[n]));
-					}
-				}
-			}
+			//show tetro
+			rst.blit(statSprites[n], x, y);
+			//info
+			rst.drawString(x+5, y, std::to_string(stats[n]));
 			y+=5;
 		}
-		//stats text
-		rst.drawString(70, 37, "Statistics");
 
 		//combo
 		if (combo>0) {
@@ -534,12 +574,9 @@ class Demo : public Engine {
 		1, 0, 0, 1, 0, 1, 1, 1, 0, 1, 0, 1, 1, 0, 1//k
 	};
 
+	//ignores the raster's char and color, see digitSprites
 	void showDigit(Raster& rst, int x, int y, int dig) {
-		for (int i=0; i<3; i++) {
-			for (int j=0; j<5; j++) {
-				if (digits[i+j*3+dig*15]) rst.putPixel(x+i, y+j);
-			}
-		}
+		rst.blit(digitSprites[dig], x, y);
 	}
 
 	void showInt(Raster& rst, int x, int y, int num_){
@@ -565,7 +602,7 @@ class Demo : public Engine {
 };
 
 int main() {
-	srand(time(NULL));
+	Random::seed(time(NULL));
 
 	//init custom graphics engine
 	Demo d;
@@ -1,5 +1,6 @@
 #include "Engine.h"
 #include "maths/Maths.h"
+#include "maths/Random.h"
 #include "geom/AABB2D.h"
 using namespace displib;
 
@@ -116,7 +117,7 @@ class Demo : public Engine {
 };
 
 int main() {
-	srand(time(NULL));
+	Random::seed(time(NULL));
 
 	//init custom graphics engine
 	Demo d;
@@ -2,6 +2,7 @@
 
 #include "Engine.h"
 #include "maths/Maths.h"
+#include "maths/Random.h"
 #include "geom/AABB2D.h"
 using namespace displib;
 
@@ -126,9 +127,6 @@ class Demo : public Engine {
 	}
 
 	void draw(Raster& rst) override {
-		rst.setChar(' ');
-		rst.fillRect(0, 0, width, height);
-
 		std::vector<std::pair<float2, float2>> lines;
 		auto line=[&lines](float2 a, float2 b) {
 			lines.push_back({a, b});
@@ -175,20 +173,11 @@ class Demo : public Engine {
 			}
 		}
 
+		//outside the contours is ground, scanline the inside back to air
 		rst.setChar('#');
-		for (int i=0; i<width; i++) {
-			for (int j=0; j<height; j++) {
-				float2 pt(i+.1, j+.1);
-				float2 ptExt(pt.x+1, pt.y);
-				int num=0;
-				for (const auto& c:lines) {
-					float t, u;
-					Maths::lineLineIntersection(pt, ptExt, c.first, c.second, &t, &u);
-					if (t>0&&u>0&&u<1) num++;
-				}
-				if (num%2==0) rst.putPixel(i, j);
-			}
-		}
+		rst.fillRect(0, 0, width, height);
+		rst.setChar(' ');
+		rst.fillSegments(lines);
 
 		rst.setChar(0x2588);
 		for (const auto& c:lines) {
@@ -198,7 +187,7 @@ class Demo : public Engine {
 };
 
 int main() {
-	srand(time(NULL));
+	Random::seed(time(NULL));
 
 	//init custom graphics engine
 	Demo d;